@@ -0,0 +1,69 @@
+## -*- mode: CMake -*-
+##
+## Copyright (c) 2026 The University of Utah
+## All rights reserved.
+##
+## This file is part of `csmith', a random generator of C programs.
+##
+## Redistribution and use in source and binary forms, with or without
+## modification, are permitted provided that the following conditions are met:
+##
+##   * Redistributions of source code must retain the above copyright notice,
+##     this list of conditions and the following disclaimer.
+##
+##   * Redistributions in binary form must reproduce the above copyright
+##     notice, this list of conditions and the following disclaimer in the
+##     documentation and/or other materials provided with the distribution.
+##
+## THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+## AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+## IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+## ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+## LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+## CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+## SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+## INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+## CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+## ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+## POSSIBILITY OF SUCH DAMAGE.
+
+###############################################################################
+
+# Write a C++ source file that holds the text of the runtime headers, for
+# `--self-contained'.  Run as
+#
+#   cmake -DOUTPUT=<file> -DSOURCE_DIR=<dir> -DBINARY_DIR=<dir>
+#         -DHEADERS=<hdr>,<hdr>,... -P EmbedRuntimeHeaders.cmake
+#
+# Each header is looked up in SOURCE_DIR and then in BINARY_DIR, where the
+# headers made by M4 live.  Every line of a header becomes one string
+# literal, so that no literal comes near the length limits of compilers.
+
+string(REPLACE "," ";" HEADERS "${HEADERS}")
+
+set(text "// Generated by EmbedRuntimeHeaders.cmake.  Do not edit.\n")
+set(text "${text}\n#include \"RuntimeInliner.h\"\n")
+set(text "${text}\nconst RuntimeHeader runtime_headers[] = {\n")
+
+foreach(hdr IN LISTS HEADERS)
+  if(EXISTS "${SOURCE_DIR}/${hdr}")
+    file(READ "${SOURCE_DIR}/${hdr}" content)
+  else()
+    file(READ "${BINARY_DIR}/${hdr}" content)
+  endif()
+  string(REPLACE "\r" "" content "${content}")
+  string(REPLACE "\\" "\\\\" content "${content}")
+  string(REPLACE "\"" "\\\"" content "${content}")
+  # Keep `??' sequences from being read as trigraphs.
+  string(REPLACE "?" "\\?" content "${content}")
+  string(REPLACE "\n" "\\n\"\n\t\"" content "${content}")
+  set(text "${text}\t{ \"${hdr}\",\n\t\"${content}\" },\n")
+endforeach(hdr)
+
+set(text "${text}\t{ 0, 0 }\n};\n")
+
+file(WRITE "${OUTPUT}" "${text}")
+
+###############################################################################
+
+## End of file.
@@ -44,14 +44,42 @@
 #define __STDC_LIMIT_MACROS
 #include "random_inc.h"
 
+/*
+ * The checksum is CRC-32, updated one byte at a time, unless one of these
+ * is defined (csmith --crc writes the define into the program):
+ *
+ *   CSMITH_CRC_SLICE8: CRC-32 through slice-by-8 tables.  The checksums are
+ *   the same as with the default.
+ *   CSMITH_CRC32C: CRC-32C (Castagnoli), with the SSE4.2 crc32 instruction
+ *   when the compiler targets it, and with slice-by-8 tables otherwise.
+ *   The checksums differ from CRC-32, but not between the two paths.
+ */
+#ifdef CSMITH_CRC32C
+#define CRC32_POLY 0x82F63B78UL
+#else
+#define CRC32_POLY 0xEDB88320UL
+#endif
+
+#if defined(CSMITH_CRC32C) && defined(__SSE4_2__)
+#include <nmmintrin.h>
+#define CSMITH_CRC_HW
+#elif defined(CSMITH_CRC32C) || defined(CSMITH_CRC_SLICE8)
+#define CSMITH_CRC_SLICED
+#endif
+
 static uint32_t crc32_tab[256];
 static uint32_t crc32_context = 0xFFFFFFFFUL;
 
+#ifdef CSMITH_CRC_SLICED
+/* crc32_slice_tab[k-1][b]: the CRC of byte b followed by k zero bytes */
+static uint32_t crc32_slice_tab[7][256];
+#endif
+
 static void 
 crc32_gentab (void)
 {
 	uint32_t crc;
-	const uint32_t poly = 0xEDB88320UL;
+	const uint32_t poly = CRC32_POLY;
 	int i, j;
 	
 	for (i = 0; i < 256; i++) {
@@ -65,23 +93,46 @@ crc32_gentab (void)
 		}
 		crc32_tab[i] = crc;
 	}
+#ifdef CSMITH_CRC_SLICED
+	for (i = 0; i < 256; i++) {
+		crc = crc32_tab[i];
+		for (j = 0; j < 7; j++) {
+			crc = (crc >> 8) ^ crc32_tab[crc & 0xFF];
+			crc32_slice_tab[j][i] = crc;
+		}
+	}
+#endif
 }
 
 static void 
 crc32_byte (uint8_t b) {
+#ifdef CSMITH_CRC_HW
+	crc32_context = _mm_crc32_u8(crc32_context, b);
+#else
 	crc32_context = 
 		((crc32_context >> 8) & 0x00FFFFFF) ^ 
 		crc32_tab[(crc32_context ^ b) & 0xFF];
+#endif
 }
 
 #if defined(__SPLAT__) || defined(NO_LONGLONG)
 static void 
 crc32_8bytes (uint32_t val)
 {
+#if defined(CSMITH_CRC_HW)
+	crc32_context = _mm_crc32_u32(crc32_context, val);
+#elif defined(CSMITH_CRC_SLICED)
+	uint32_t c = crc32_context ^ val;
+	crc32_context = crc32_slice_tab[2][c & 0xff] ^
+		crc32_slice_tab[1][(c>>8) & 0xff] ^
+		crc32_slice_tab[0][(c>>16) & 0xff] ^
+		crc32_tab[c>>24];
+#else
 	crc32_byte ((val>>0) & 0xff);
 	crc32_byte ((val>>8) & 0xff);
 	crc32_byte ((val>>16) & 0xff);
 	crc32_byte ((val>>24) & 0xff);
+#endif
 }
 
 static void 
@@ -96,6 +147,23 @@ transparent_crc (uint32_t val, char* vname, int flag)
 static void 
 crc32_8bytes (uint64_t val)
 {
+#if defined(CSMITH_CRC_HW) && defined(__x86_64__)
+	crc32_context = (uint32_t)_mm_crc32_u64(crc32_context, val);
+#elif defined(CSMITH_CRC_HW)
+	crc32_context = _mm_crc32_u32(crc32_context, (uint32_t)val);
+	crc32_context = _mm_crc32_u32(crc32_context, (uint32_t)(val>>32));
+#elif defined(CSMITH_CRC_SLICED)
+	uint32_t lo = crc32_context ^ (uint32_t)val;
+	uint32_t hi = (uint32_t)(val>>32);
+	crc32_context = crc32_slice_tab[6][lo & 0xff] ^
+		crc32_slice_tab[5][(lo>>8) & 0xff] ^
+		crc32_slice_tab[4][(lo>>16) & 0xff] ^
+		crc32_slice_tab[3][lo>>24] ^
+		crc32_slice_tab[2][hi & 0xff] ^
+		crc32_slice_tab[1][(hi>>8) & 0xff] ^
+		crc32_slice_tab[0][(hi>>16) & 0xff] ^
+		crc32_tab[hi>>24];
+#else
 	crc32_byte ((val>>0) & 0xff);
 	crc32_byte ((val>>8) & 0xff);
 	crc32_byte ((val>>16) & 0xff);
@@ -104,6 +172,7 @@ crc32_8bytes (uint64_t val)
 	crc32_byte ((val>>40) & 0xff);
 	crc32_byte ((val>>48) & 0xff);
 	crc32_byte ((val>>56) & 0xff);
+#endif
 }
 
 static void 
@@ -120,8 +189,18 @@ transparent_crc (uint64_t val, char* vname, int flag)
 static void 
 transparent_crc_bytes (char *ptr, int nbytes, char* vname, int flag)
 {
-    int i;
-    for (i=0; i<nbytes; i++) {
+    int i = 0;
+#if (defined(CSMITH_CRC_HW) || defined(CSMITH_CRC_SLICED)) && !(defined(__SPLAT__) || defined(NO_LONGLONG))
+    for (; i + 8 <= nbytes; i += 8) {
+        uint64_t val = 0;
+        int j;
+        for (j = 7; j >= 0; j--) {
+            val = (val << 8) | (uint8_t)ptr[i + j];
+        }
+        crc32_8bytes(val);
+    }
+#endif
+    for (; i<nbytes; i++) {
         crc32_byte(ptr[i]);
     }
 	if (flag) {
@@ -129,6 +208,34 @@ transparent_crc_bytes (char *ptr, int nbytes, char* vname, int flag)
 	}
 }
 
+/*
+ * Hash the <n> integers at <p>, in the same way as calling transparent_crc
+ * on each of them (csmith --bulk-array-hash).
+ */
+#define TRANSPARENT_CRC_ARRAY(name, type) \
+static void \
+transparent_crc_array_##name (const type *p, int n, char* vname, int flag) \
+{ \
+	int i; \
+	for (i=0; i<n; i++) { \
+		crc32_8bytes(p[i]); \
+	} \
+	if (flag) { \
+		printf("...checksum after hashing %s : %lX\n", vname, crc32_context ^ 0xFFFFFFFFUL); \
+	} \
+}
+
+TRANSPARENT_CRC_ARRAY(int8, int8_t)
+TRANSPARENT_CRC_ARRAY(uint8, uint8_t)
+TRANSPARENT_CRC_ARRAY(int16, int16_t)
+TRANSPARENT_CRC_ARRAY(uint16, uint16_t)
+TRANSPARENT_CRC_ARRAY(int32, int32_t)
+TRANSPARENT_CRC_ARRAY(uint32, uint32_t)
+#if !(defined(__SPLAT__) || defined(NO_LONGLONG))
+TRANSPARENT_CRC_ARRAY(int64, int64_t)
+TRANSPARENT_CRC_ARRAY(uint64, uint64_t)
+#endif
+
 /*****************************************************************************/
 
 #endif
@@ -56,6 +56,10 @@ extern int printf (const char *, ...);
 #include "safe_math_macros_notmp.h"
 #elif defined (USE_MATH_MACROS)
 #include "safe_math_macros.h"
+#elif defined (USE_MATH_BUILTINS)
+#define FUNC_NAME(x) (safe_##x)
+#include "safe_math_builtins.h"
+#undef FUNC_NAME
 #else
 #define FUNC_NAME(x) (safe_##x)
 #include "safe_math.h"
@@ -109,6 +113,35 @@ transparent_crc_bytes (char *ptr, int nbytes, char* vname, int flag)
 #endif
 }
 
+#ifdef NO_PRINTF
+#define TRANSPARENT_CRC_ARRAY_PRINT(vname)
+#else
+#define TRANSPARENT_CRC_ARRAY_PRINT(vname) \
+  printf("...checksum after hashing %s : %lX\n", vname, crc32_context ^ 0xFFFFFFFFUL);
+#endif
+
+#define TRANSPARENT_CRC_ARRAY(name, type) \
+static void \
+transparent_crc_array_##name (const type *p, int n, char* vname, int flag) \
+{ \
+  int i; \
+  for (i=0; i<n; i++) { \
+    crc32_context += p[i]; \
+  } \
+  if (flag) { \
+    TRANSPARENT_CRC_ARRAY_PRINT(vname) \
+  } \
+}
+
+TRANSPARENT_CRC_ARRAY(int8, int8_t)
+TRANSPARENT_CRC_ARRAY(uint8, uint8_t)
+TRANSPARENT_CRC_ARRAY(int16, int16_t)
+TRANSPARENT_CRC_ARRAY(uint16, uint16_t)
+TRANSPARENT_CRC_ARRAY(int32, int32_t)
+TRANSPARENT_CRC_ARRAY(uint32, uint32_t)
+TRANSPARENT_CRC_ARRAY(int64, int64_t)
+TRANSPARENT_CRC_ARRAY(uint64, uint64_t)
+
 #ifdef NO_PRINTF
 void my_puts (char *p)
 {
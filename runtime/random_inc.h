@@ -95,6 +95,10 @@ char __executed_checks[N_WRAP+1];
 #include "safe_math_macros_notmp.h"
 #elif defined (USE_MATH_MACROS)
 #include "safe_math_macros.h"
+#elif defined (USE_MATH_BUILTINS)
+#define FUNC_NAME(x) (safe_##x)
+#include "safe_math_builtins.h"
+#undef FUNC_NAME
 #else
 #define FUNC_NAME(x) (safe_##x)
 #include "safe_math.h"
@@ -39,13 +39,13 @@
 
 #include "DefaultRndNumGenerator.h"
 #include "DFSRndNumGenerator.h"
+#include "CGOptions.h"
 
 using namespace std;
 
-#ifndef HAVE_LRAND48
+#ifndef HAVE_NRAND48
 extern "C" {
-	extern void srand48(long seed);
-	extern long lrand48(void);
+	extern long nrand48(unsigned short xsubi[3]);
 }
 #endif
 
@@ -53,6 +53,12 @@ const char *AbsRndNumGenerator::hex1 = "0123456789ABCDEF";
 
 const char *AbsRndNumGenerator::dec1 = "0123456789";
 
+thread_local RNG_ENGINE AbsRndNumGenerator::engine_ = rRand48Engine;
+
+thread_local unsigned short AbsRndNumGenerator::rand48_state_[3];
+
+thread_local Xoshiro256 AbsRndNumGenerator::xoshiro256_state_;
+
 AbsRndNumGenerator::AbsRndNumGenerator()
 {
 	//Nothing to do
@@ -90,13 +96,19 @@ AbsRndNumGenerator::make_rndnum_generator(RNDNUM_GENERATOR impl, const unsigned
 void
 AbsRndNumGenerator::seedrand(const unsigned long seed )
 {
-#ifdef HAVE_SRAND48_DETERMINISTIC
-	// OpenBSD requires a special call to activate the standard,
-	// deterministic behavior of `lrand48'.
-	srand48_deterministic(seed);
-#else
-	srand48(seed);
-#endif
+	if (CGOptions::rng() == "xoshiro256") {
+		// The seed is the stream id, so the programs of different seeds
+		// are generated from non-overlapping parts of the sequence.
+		engine_ = rXoshiro256Engine;
+		xoshiro256_state_.seed_stream(seed);
+		return;
+	}
+	// Same initial state as `srand48(seed)', so that `nrand48' returns the
+	// sequence `lrand48' would.
+	engine_ = rRand48Engine;
+	rand48_state_[0] = 0x330e;
+	rand48_state_[1] = static_cast<unsigned short>(seed);
+	rand48_state_[2] = static_cast<unsigned short>(seed >> 16);
 }
 
 /*
@@ -128,7 +140,10 @@ AbsRndNumGenerator::rnd_shuffle(unsigned int n)
 unsigned long
 AbsRndNumGenerator::genrand(void)
 {
-	return lrand48();
+	// keep the 31-bit range of nrand48 for either engine
+	if (engine_ == rXoshiro256Engine)
+		return static_cast<unsigned long>(xoshiro256_state_.next() >> 33);
+	return nrand48(rand48_state_);
 }
 
 std::string
@@ -32,8 +32,10 @@
 
 #include <string>
 #include "CommonMacros.h"
+#include "Xoshiro256.h"
 
 class Filter;
+class SequenceWriter;
 
 enum RNDNUM_GENERATOR {
 	rDefaultRndNumGenerator = 0,
@@ -42,6 +44,12 @@ enum RNDNUM_GENERATOR {
 
 #define MAX_RNDNUM_GENERATOR (rDFSRndNumGenerator+1)
 
+// The engines the generators draw their numbers from, see --rng
+enum RNG_ENGINE {
+	rRand48Engine = 0,
+	rXoshiro256Engine,
+};
+
 // I could make AbsRndNumGenerator not pure, but want to force each subclass implement
 // it's own member functions, in case of forgetting something.
 class AbsRndNumGenerator
@@ -65,6 +73,8 @@ public:
 
 	virtual void get_sequence(std::string &sequence) = 0;
 
+	virtual void get_sequence(SequenceWriter &writer) = 0;
+
 	virtual unsigned int rnd_upto(const unsigned int n, const Filter *f = NULL, const std::string *where = NULL) = 0;
 
 	virtual bool rnd_flipcoin(const unsigned int p, const Filter *f = NULL, const std::string *where = NULL) = 0;
@@ -92,6 +102,14 @@ private:
 
 	static const char *dec1;
 
+	// The engine and its state.  They are kept per thread, so that
+	// programs generated in parallel threads don't share a random sequence.
+	static thread_local RNG_ENGINE engine_;
+
+	static thread_local unsigned short rand48_state_[3];
+
+	static thread_local Xoshiro256 xoshiro256_state_;
+
 	// Don't implement them
 	DISALLOW_COPY_AND_ASSIGN(AbsRndNumGenerator);
 };
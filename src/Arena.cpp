@@ -0,0 +1,103 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#if HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "Arena.h"
+
+#include <cstddef>
+
+// Size of the blocks of the program arena.
+#define PROGRAM_ARENA_BLOCK_SIZE (64 * 1024)
+
+static const std::size_t arena_alignment = alignof(std::max_align_t);
+
+Arena::Arena(std::size_t block_size)
+	: block_size_(block_size),
+	  next_block_(0),
+	  curr_(NULL),
+	  end_(NULL)
+{
+
+}
+
+Arena::~Arena()
+{
+	reset();
+	for (size_t i = 0; i < blocks_.size(); ++i) {
+		delete [] blocks_[i];
+	}
+	blocks_.clear();
+}
+
+void *
+Arena::allocate(std::size_t size)
+{
+	size = (size + arena_alignment - 1) & ~(arena_alignment - 1);
+	if (size > block_size_) {
+		char *p = new char[size];
+		large_blocks_.push_back(p);
+		return p;
+	}
+
+	if (static_cast<std::size_t>(end_ - curr_) < size) {
+		if (next_block_ == blocks_.size())
+			blocks_.push_back(new char[block_size_]);
+		curr_ = blocks_[next_block_++];
+		end_ = curr_ + block_size_;
+	}
+	void *p = curr_;
+	curr_ += size;
+	return p;
+}
+
+/*
+ * Release everything allocated so far.  Nothing allocated from the arena
+ * may be used after this.
+ */
+void
+Arena::reset()
+{
+	for (size_t i = 0; i < large_blocks_.size(); ++i) {
+		delete [] large_blocks_[i];
+	}
+	large_blocks_.clear();
+	next_block_ = 0;
+	curr_ = NULL;
+	end_ = NULL;
+}
+
+Arena &
+Arena::program_arena()
+{
+	static thread_local Arena arena(PROGRAM_ARENA_BLOCK_SIZE);
+	return arena;
+}
@@ -0,0 +1,84 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <vector>
+
+#include "CommonMacros.h"
+
+// Allocate the objects of a class from the program arena.  `delete' still
+// runs the destructor, but the memory is only released when the whole
+// program is dropped.
+#define ALLOCATE_FROM_PROGRAM_ARENA \
+	static void *operator new(std::size_t size) { return Arena::program_arena().allocate(size); } \
+	static void operator delete(void *) { }
+
+/*
+ * A monotonic allocator: objects are carved out of large blocks, one after
+ * another, and are all released at once by `reset'.
+ *
+ * The program arena holds the AST, the facts and the CFG edges of the
+ * program being generated.  Each thread has its own, and it is reset once
+ * everything it holds has been deleted, at the end of each program.
+ */
+class Arena
+{
+public:
+	explicit Arena(std::size_t block_size);
+
+	~Arena();
+
+	void *allocate(std::size_t size);
+
+	void reset();
+
+	static Arena &program_arena();
+
+private:
+	const std::size_t block_size_;
+
+	// The blocks are kept by `reset' and reused by the next program.
+	std::vector<char *> blocks_;
+
+	// Allocations larger than a block get their own memory.
+	std::vector<char *> large_blocks_;
+
+	std::size_t next_block_;
+
+	char *curr_;
+
+	char *end_;
+
+	DISALLOW_COPY_AND_ASSIGN(Arena);
+};
+
+#endif // ARENA_H
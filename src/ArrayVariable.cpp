@@ -452,20 +452,28 @@ ArrayVariable::no_loop_initializer(void) const
 	return type->eType==eStruct || type->eType==eUnion || is_const() || is_global() || (init_values.size() > 0);
 }
 
+// magic number used by build_init_recursive to choose initial values
+static thread_local unsigned init_seed = 0xABCDEF;
+
+void
+ArrayVariable::doFinalization(void)
+{
+	init_seed = 0xABCDEF;
+}
+
 // print the initializer recursively for multi-dimension arrays
 // this is based on John's idea
 string
 ArrayVariable::build_init_recursive(size_t dimen, const vector<string>& init_strings) const
 {
 	assert (dimen < get_dimension());
-	static unsigned seed = 0xABCDEF;
 	string ret = "{";
 	for (size_t i=0; i<sizes[dimen]; i++) {
 		if (dimen == sizes.size() - 1) {
 			// use magic number to choose an initial value
-			size_t rnd_index = ((seed * seed + (i+7) * (i+13)) * 52369) % (init_strings.size());
+			size_t rnd_index = ((init_seed * init_seed + (i+7) * (i+13)) * 52369) % (init_strings.size());
 			ret += init_strings[rnd_index];
-			seed++;
+			init_seed++;
 		 } else {
 			ret += build_init_recursive(dimen + 1, init_strings);
 		 }
@@ -726,7 +734,7 @@ ArrayVariable::output_addr_checks(std::ostream &out, const Variable* var, string
 	out << " == &";
 	output_with_indices(out, ctrl_vars);
 	out << field_name;
-	out << ")" << endl;
+	out << ")" << '\n';
 	output_open_encloser("{", out, indent);
 	output_tab(out, indent);
 	out << "printf(\"   ";
@@ -741,7 +749,7 @@ ArrayVariable::output_addr_checks(std::ostream &out, const Variable* var, string
 		out << ", ";
 		out << ctrl_vars[i]->get_actual_name();
 	}
-	out << ");" << endl;
+	out << ");" << '\n';
 	output_tab(out, indent);
 	out << "break;";
 	output_close_encloser("}", out, indent);
@@ -770,6 +778,58 @@ ArrayVariable::make_print_index_str(const vector<const Variable *> &cvs) const
 	return str;
 }
 
+/* -------------------------------------------------------------
+ *  hash all items of an array of integers with one call over each of
+ *  its innermost rows, if it is not volatile. A pointer into a row may
+ *  not be walked past the end of that row, so the outer dimensions are
+ *  still looped over. Return false if the array has to be hashed item
+ *  by item.
+ ***************************************************************/
+bool
+ArrayVariable::output_bulk_hash(std::ostream& out) const
+{
+	if (type->eType != eSimple || type->simple_type == eFloat ||
+		type->SizeInBytes() > 8 || is_volatile()) {
+		return false;
+	}
+
+	size_t i;
+	size_t rows = get_dimension() - 1;
+	int indent = 1;
+	const vector<const Variable*>& cvs = Variable::get_last_ctrl_vars();
+	for (i=0; i<rows; i++) {
+		output_tab(out, indent);
+		out << "for (";
+		out << cvs[i]->get_actual_name();
+		out << " = 0; ";
+		out << cvs[i]->get_actual_name();
+		out << " < " << sizes[i] << "; ";
+		out << cvs[i]->get_actual_name();
+		if (CGOptions::post_incr_operator()) {
+			out << "++)";
+		}
+		else {
+			out << " = " << cvs[i]->get_actual_name() << " + 1)";
+		}
+		outputln(out);
+		output_open_encloser("{", out, indent);
+	}
+	output_tab(out, indent);
+	out << "transparent_crc_array_" << (type->is_signed() ? "int" : "uint") << (type->SizeInBytes() * 8);
+	out << "(&" << get_actual_name();
+	for (i=0; i<rows; i++) {
+		out << "[" << cvs[i]->get_actual_name() << "]";
+	}
+	out << "[0], " << sizes[rows] << ", \"" << get_actual_name() << "\", print_hash_value);" << '\n';
+	for (i=0; i<rows; i++) {
+		output_close_encloser("}", out, indent);
+	}
+	if (rows) {
+		outputln(out);
+	}
+	return true;
+}
+
 /* -------------------------------------------------------------
  *  hash all array items
  ***************************************************************/
@@ -777,6 +837,7 @@ void
 ArrayVariable::hash(std::ostream& out) const
 {
 	if (collective != 0) return;
+	if (CGOptions::bulk_array_hash() && CGOptions::compute_hash() && output_bulk_hash(out)) return;
 	vector<string> field_names;
 	vector<const Type *> field_types;
 	vector<int> included_fields;
@@ -828,17 +889,17 @@ ArrayVariable::hash(std::ostream& out) const
 				output_tab(out, indent);
 				out << "transparent_crc_bytes(&" << vname << field_names[j] << ", ";
 				out << "sizeof(" << vname << field_names[j] << "), ";
-				out << "\"" << vname << field_names[j] << "\", print_hash_value);" << endl;
+				out << "\"" << vname << field_names[j] << "\", print_hash_value);" << '\n';
 			} else {
 				output_tab(out, indent);
 				out << "transparent_crc(" << vname << field_names[j] << ", \"";
-				out << vname << field_names[j] << "\", print_hash_value);" << endl;
+				out << vname << field_names[j] << "\", print_hash_value);" << '\n';
 			}
 		}
 		// print the index value
 		if (CGOptions::hash_value_printf()) {
 			output_tab(out, indent);
-			out << "if (print_hash_value) " << make_print_index_str(cvs) << endl;
+			out << "if (print_hash_value) " << make_print_index_str(cvs) << '\n';
 		}
 	}
 	else {
@@ -44,6 +44,7 @@ class ArrayVariable : public Variable
 {
 public:
 	static ArrayVariable* CreateArrayVariable(const CGContext& cg_context, Block* blk, const std::string &name, const Type *type, const Expression* init, const CVQualifiers* qfer, const Variable* isFieldVarOf);
+	static void doFinalization(void);
 	ArrayVariable(const ArrayVariable& av);
 	virtual ~ArrayVariable(void);
 
@@ -89,6 +90,7 @@ public:
 private:
 	ArrayVariable(Block* blk, const std::string &name, const Type *type, const Expression* init, const CVQualifiers* qfer, const vector<unsigned int>& sizes, const Variable* isFieldVarOf);
 
+	bool output_bulk_hash(std::ostream &out) const;
 
 	const std::vector<unsigned int> sizes;
 	std::vector<const Expression*> indices;
@@ -31,11 +31,24 @@ AttributeGenerator::Output(std::ostream &out)
 		out << "))";
 }
 
+void
+AttributeGenerator::clear()
+{
+	vector<Attribute*>::iterator itr;
+	for(itr = attributes.begin(); itr != attributes.end(); itr++)
+		delete (*itr);
+	attributes.clear();
+}
+
 Attribute::Attribute(string name, int prob)
 	:  name(name), prob(prob)
 {
 }
 
+Attribute::~Attribute()
+{
+}
+
 BooleanAttribute::BooleanAttribute(string name, int prob)
 	: Attribute(name, prob)
 {
@@ -0,0 +1,65 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#if HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "BitSet.h"
+
+void
+BitSet::set(std::size_t i)
+{
+	std::size_t w = i / WORD_BITS;
+	if (w >= words_.size()) {
+		words_.resize(w + 1, 0);
+	}
+	words_[w] |= Word(1) << (i % WORD_BITS);
+}
+
+void
+BitSet::reset(std::size_t i)
+{
+	std::size_t w = i / WORD_BITS;
+	if (w < words_.size()) {
+		words_[w] &= ~(Word(1) << (i % WORD_BITS));
+	}
+}
+
+bool
+BitSet::intersects(const BitSet &other) const
+{
+	std::size_t len = words_.size() < other.words_.size() ? words_.size() : other.words_.size();
+	for (std::size_t w = 0; w < len; ++w) {
+		if (words_[w] & other.words_[w]) {
+			return true;
+		}
+	}
+	return false;
+}
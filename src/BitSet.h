@@ -0,0 +1,63 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef BIT_SET_H
+#define BIT_SET_H
+
+#include <cstddef>
+#include <vector>
+
+/*
+ * A growable set of small non-negative integers, one bit per member.  Used
+ * for sets of variables, indexed by Variable::id.
+ */
+class BitSet
+{
+public:
+	bool test(std::size_t i) const
+	{
+		return i / WORD_BITS < words_.size() && (words_[i / WORD_BITS] >> (i % WORD_BITS)) & 1;
+	}
+
+	void set(std::size_t i);
+
+	void reset(std::size_t i);
+
+	void clear() { words_.clear(); }
+
+	bool intersects(const BitSet &other) const;
+
+private:
+	typedef unsigned long Word;
+	static const std::size_t WORD_BITS = sizeof(Word) * 8;
+
+	std::vector<Word> words_;
+};
+
+#endif // BIT_SET_H
@@ -78,6 +78,10 @@
 #include <memory>
 using namespace std;
 
+// more iterations than this in find_fixed_point mean the analysis is not
+// converging, and the block is cut short
+#define MAX_FIXED_POINT_ITERATIONS 7
+
 ///////////////////////////////////////////////////////////////////////////////
 Block *find_block_by_id(int blk_id)
 {
@@ -1152,25 +1156,50 @@ bool Block::find_fixed_point(vector<const Fact *> inputs, vector<const Fact *> &
 	FactMgr *fm = get_fact_mgr(&cg_context);
 	// include outputs from all back edges leading to this block
 	size_t i;
-	static int g = 0;
+	static thread_local int g = 0;
 	vector<const CFGEdge *> edges;
+	// the output of each back edge source as of its last merge. Merging an
+	// unchanged output again can not change the inputs, so it is skipped.
+	// The statements are still all revisited rather than kept on a worklist:
+	// each one has to replay its effect into cg_context, and one whose input
+	// is unchanged already returns its stored output
+	vector<const Statement *> merged_srcs;
+	vector<FactVec> merged_outs;
 	int cnt = 0;
 	do
 	{
 		// if we have never visited the block, force the visitor to go through all statements at least once
 		if (fm->map_visited[this])
 		{
-			if (cnt++ > 7)
+			if (cnt++ > MAX_FIXED_POINT_ITERATIONS)
 			{
-				// takes too many iterations to reach a fixed point, must be something wrong
-				assert(0);
+				// takes too many iterations to reach a fixed point: fail, and let
+				// post_creation_analysis drop the last statement and try again.
+				// An empty block has nothing to drop
+				fail_index = static_cast<int>(stms.size()) - 1;
+				return log_analysis_fail("Block. too many iterations to reach a fixed point");
 			}
 			find_edges_in(edges, false, true);
 			for (i = 0; i < edges.size(); i++)
 			{
 				const Statement *src = edges[i]->src;
 				// assert(fm->map_visited[src]);
-				merge_facts(inputs, fm->map_facts_out[src]);
+				const FactVec &src_out = fm->map_facts_out[src];
+				int pos = find_stm_in_set(merged_srcs, src);
+				if (pos == -1)
+				{
+					merged_srcs.push_back(src);
+					merged_outs.push_back(src_out);
+				}
+				else if (merged_outs[pos] == src_out)
+				{
+					continue;
+				}
+				else
+				{
+					merged_outs[pos] = src_out;
+				}
+				merge_facts(inputs, src_out);
 			}
 		}
 		if (!visit_once)
@@ -1372,6 +1401,12 @@ void Block::post_creation_analysis(CGContext &cg_context, const Effect &pre_effe
 		cg_context.reset_effect_accum(pre_effect);
 		while (!find_fixed_point(facts_copy, post_facts, cg_context, index, need_revisit))
 		{
+			// with no statement to drop, trying again would fail the same way
+			if (index < 0 || static_cast<size_t>(index) >= stms.size())
+			{
+				Error::set_error(ERROR);
+				return;
+			}
 			size_t i, len;
 			len = stms.size();
 			for (i = index; i < len; i++)
@@ -47,6 +47,7 @@
 
 #include "Statement.h"
 #include "Type.h"
+#include "VariableIndex.h"
 #include <nlohmann/json.hpp> 
 
 class CGContext;
@@ -89,6 +90,8 @@ public:
 	std::vector<Statement *> stms;
 	std::vector<Statement *> deleted_stms;
 	std::vector<Variable *> local_vars;
+	// local_vars bucketed by type, synced on use by VariableSelector
+	mutable VariableIndex local_var_index;
 	mutable std::map<std::string, enum eSimpleType> macro_tmp_vars;
 
 	std::string create_new_tmp_var(enum eSimpleType type) const;
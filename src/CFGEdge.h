@@ -32,6 +32,7 @@
 
 #include <iostream>
 #include <vector>
+#include "Arena.h"
 using namespace std;
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -44,6 +45,8 @@ class Block;
 class CFGEdge
 {
 public:
+	ALLOCATE_FROM_PROGRAM_ARENA
+
 	CFGEdge(const Statement* src, const Statement* dest, bool post_dest, bool back_link);
 	CFGEdge(const CFGEdge &edge);
 	virtual ~CFGEdge(void);
@@ -35,6 +35,7 @@
 
 #include "CGOptions.h"
 #include <iostream>
+#include <fstream>
 #include <cassert>
 #include <cstring>
 #include <map>
@@ -75,14 +76,34 @@ int CGOptions::pointer_size_ = 0;
 #define DEFINE_GETTER_SETTER_STRING_REF(f) \
 	DEFINE_GETTER_SETTER(std::string, "", f)
 
+/*
+ * Same as above, except that the value is kept per thread.
+ */
+#define DEFINE_THREAD_LOCAL_GETTER_SETTER_BOOL(f) \
+	thread_local bool CGOptions::f##_ = false; \
+	bool \
+	CGOptions::f(void) { return f##_; }	\
+	bool \
+	CGOptions::f(bool p) { f##_ = p; return p; }
+
 ///////////////////////////////////////////////////////////////////////////////
 
 DEFINE_GETTER_SETTER_BOOL(compute_hash)
+DEFINE_GETTER_SETTER_STRING_REF(crc_algorithm)
 DEFINE_GETTER_SETTER_BOOL(depth_protect)
 DEFINE_GETTER_SETTER_INT (max_split_files)
 DEFINE_GETTER_SETTER_STRING_REF(split_files_dir)
 DEFINE_GETTER_SETTER_STRING_REF(output_file)
 DEFINE_GETTER_SETTER_STRING_REF(temp_file)
+DEFINE_GETTER_SETTER_INT (batch_count)
+DEFINE_GETTER_SETTER_STRING_REF(batch_output_dir)
+DEFINE_GETTER_SETTER_INT (batch_jobs)
+DEFINE_GETTER_SETTER_BOOL(fork_server)
+DEFINE_GETTER_SETTER_BOOL(rejection_sampling)
+DEFINE_GETTER_SETTER_STRING_REF(rng)
+DEFINE_GETTER_SETTER_STRING_REF(archive_file)
+DEFINE_GETTER_SETTER_BOOL(archive_extract)
+DEFINE_GETTER_SETTER_STRING_REF(dedup_file)
 DEFINE_GETTER_SETTER_INT (max_funcs)
 DEFINE_GETTER_SETTER_INT (max_params)
 DEFINE_GETTER_SETTER_INT (max_block_size)
@@ -112,6 +133,7 @@ DEFINE_GETTER_SETTER_BOOL(random_based)
 DEFINE_GETTER_SETTER_BOOL(dfs_exhaustive)
 DEFINE_GETTER_SETTER_STRING_REF(dfs_debug_sequence)
 DEFINE_GETTER_SETTER_INT (max_exhaustive_depth)
+DEFINE_GETTER_SETTER_BOOL(dfs_checkpoint)
 DEFINE_GETTER_SETTER_BOOL(compact_output)
 DEFINE_GETTER_SETTER_INT(func1_max_params)
 DEFINE_GETTER_SETTER_BOOL(klee)
@@ -133,6 +155,8 @@ DEFINE_GETTER_SETTER_BOOL(no_delta_reduction)
 DEFINE_GETTER_SETTER_BOOL(math64)
 DEFINE_GETTER_SETTER_BOOL(inline_function)
 DEFINE_GETTER_SETTER_BOOL(math_notmp)
+DEFINE_GETTER_SETTER_BOOL(math_builtins)
+DEFINE_GETTER_SETTER_BOOL(self_contained)
 DEFINE_GETTER_SETTER_BOOL(longlong)
 DEFINE_GETTER_SETTER_BOOL(int8)
 DEFINE_GETTER_SETTER_BOOL(uint8)
@@ -150,7 +174,6 @@ DEFINE_GETTER_SETTER_BOOL(volatiles)
 DEFINE_GETTER_SETTER_BOOL(volatile_pointers)
 DEFINE_GETTER_SETTER_BOOL(const_pointers)
 DEFINE_GETTER_SETTER_BOOL(global_variables)
-DEFINE_GETTER_SETTER_BOOL(access_once)
 DEFINE_GETTER_SETTER_BOOL(strict_volatile_rule)
 DEFINE_GETTER_SETTER_BOOL(addr_taken_of_locals)
 DEFINE_GETTER_SETTER_BOOL(fresh_array_ctrl_var_names)
@@ -163,19 +186,22 @@ DEFINE_GETTER_SETTER_BOOL(accept_argc)
 DEFINE_GETTER_SETTER_BOOL(random_random)
 DEFINE_GETTER_SETTER_INT(stop_by_stmt)
 DEFINE_GETTER_SETTER_BOOL(step_hash_by_stmt)
+DEFINE_GETTER_SETTER_BOOL(step_hash_by_effect)
 DEFINE_GETTER_SETTER_BOOL(compound_assignment)
 DEFINE_GETTER_SETTER_STRING_REF(dump_default_probabilities)
 DEFINE_GETTER_SETTER_STRING_REF(dump_random_probabilities)
 DEFINE_GETTER_SETTER_STRING_REF(probability_configuration)
 DEFINE_GETTER_SETTER_BOOL(const_as_condition)
-DEFINE_GETTER_SETTER_BOOL(match_exact_qualifiers)
 DEFINE_GETTER_SETTER_BOOL(blind_check_global)
 DEFINE_GETTER_SETTER_BOOL(no_return_dead_ptr)
 DEFINE_GETTER_SETTER_BOOL(hash_value_printf)
+DEFINE_GETTER_SETTER_BOOL(bulk_array_hash)
 DEFINE_GETTER_SETTER_BOOL(signed_char_index)
 DEFINE_GETTER_SETTER_INT (max_array_num_in_loop)
 DEFINE_GETTER_SETTER_BOOL(identify_wrappers)
 DEFINE_GETTER_SETTER_BOOL(mark_mutable_const)
+DEFINE_THREAD_LOCAL_GETTER_SETTER_BOOL(force_exact_qualifiers)
+DEFINE_THREAD_LOCAL_GETTER_SETTER_BOOL(suppress_access_once)
 DEFINE_GETTER_SETTER_BOOL(force_globals_static)
 DEFINE_GETTER_SETTER_BOOL(force_non_uniform_array_init)
 DEFINE_GETTER_SETTER_INT(inline_function_prob)
@@ -218,6 +244,7 @@ CGOptions::set_default_settings(void)
 {
 	set_platform_specific_options();
 	compute_hash(true);
+	crc_algorithm(CGOPTIONS_DEFAULT_CRC_ALGORITHM);
 	max_funcs(CGOPTIONS_DEFAULT_MAX_SPLIT_FILES);
 	max_funcs(CGOPTIONS_DEFAULT_MAX_FUNCS);
 	max_params(CGOPTIONS_DEFAULT_MAX_PARAMS);
@@ -233,9 +260,16 @@ CGOptions::set_default_settings(void)
 	max_array_length_per_dimension(CGOPTIONS_DEFAULT_MAX_ARRAY_LENGTH_PER_DIMENSION);
 	max_array_length(CGOPTIONS_DEFAULT_MAX_ARRAY_LENGTH);
 	max_exhaustive_depth(CGOPTIONS_DEFAULT_MAX_EXHAUSTIVE_DEPTH);
+	dfs_checkpoint(false);
 	max_indirect_level(CGOPTIONS_DEFAULT_MAX_INDIRECT_LEVEL);
 	output_file(CGOPTIONS_DEFAULT_OUTPUT_FILE);
 	temp_file(CGOPTIONS_DEFAULT_TEMP_FILE);
+	batch_count(CGOPTIONS_DEFAULT_BATCH_COUNT);
+	batch_jobs(CGOPTIONS_DEFAULT_BATCH_JOBS);
+	fork_server(false);
+	rejection_sampling(false);
+	rng("rand48");
+	archive_extract(false);
 	interested_facts(ePointTo | eUnionWrite);
 	allow_const_volatile(true);
 	avoid_signed_overflow(true);
@@ -262,6 +296,8 @@ CGOptions::set_default_settings(void)
 	math64(true);
 	inline_function(false);
 	math_notmp(false);
+	math_builtins(false);
+	self_contained(false);
 	longlong(true);
 	int8(true);
 	uint8(true);
@@ -286,11 +322,13 @@ CGOptions::set_default_settings(void)
 	accept_argc(true);
 	stop_by_stmt(-1);
 	step_hash_by_stmt(false);
+	step_hash_by_effect(false);
 	const_as_condition(false);
 	match_exact_qualifiers(false);
 	blind_check_global(false);
 	no_return_dead_ptr(true);
 	hash_value_printf(true);
+	bulk_array_hash(false);
 	signed_char_index(true);
 	identify_wrappers(false);
 	mark_mutable_const(false);
@@ -388,6 +426,36 @@ CGOptions::pointer_size(void)
 	return pointer_size_;
 }
 
+bool CGOptions::access_once_ = false;
+
+bool
+CGOptions::access_once(bool p)
+{
+	access_once_ = p;
+	return p;
+}
+
+bool
+CGOptions::access_once(void)
+{
+	return access_once_ && !suppress_access_once_;
+}
+
+bool CGOptions::match_exact_qualifiers_ = false;
+
+bool
+CGOptions::match_exact_qualifiers(bool p)
+{
+	match_exact_qualifiers_ = p;
+	return p;
+}
+
+bool
+CGOptions::match_exact_qualifiers(void)
+{
+	return match_exact_qualifiers_ || force_exact_qualifiers_;
+}
+
 bool
 CGOptions::is_random(void)
 {
@@ -494,6 +562,145 @@ CGOptions::has_extension_conflict()
 	return false;
 }
 
+/*
+ * The batch mode generates many programs in one process, resetting the
+ * per-program state in between.  Options that keep state across programs
+ * or that choose a different program generator are not supported.
+ */
+bool
+CGOptions::has_batch_conflict()
+{
+	if (CGOptions::batch_count() < 1) {
+		conflict_msg_ = "count must be at least 1";
+		return true;
+	}
+	if (CGOptions::batch_jobs() < 1) {
+		conflict_msg_ = "jobs must be at least 1";
+		return true;
+	}
+	if (CGOptions::batch_count() == 1) {
+		if (!CGOptions::dedup_file().empty()) {
+			conflict_msg_ = "--dedup requires --count or --seed-range";
+			return true;
+		}
+		return false;
+	}
+
+	if (CGOptions::batch_jobs() > 1) {
+		if (CGOptions::batch_output_dir().empty() && CGOptions::archive_file().empty()) {
+			conflict_msg_ = "--jobs requires --output-dir or --archive";
+			return true;
+		}
+		if (CGOptions::identify_wrappers()) {
+			conflict_msg_ = "--jobs cannot be used with --identify-wrappers";
+			return true;
+		}
+	}
+
+	if (CGOptions::dfs_exhaustive()) {
+		conflict_msg_ = "--count and --seed-range cannot be used with --dfs-exhaustive";
+		return true;
+	}
+	if (CGOptions::random_random()) {
+		conflict_msg_ = "--count and --seed-range cannot be used with --random-random";
+		return true;
+	}
+	if (CGOptions::max_split_files() > 0) {
+		conflict_msg_ = "--count and --seed-range cannot be used with --max-split-files";
+		return true;
+	}
+	if (CGOptions::has_extension_support()) {
+		conflict_msg_ = "batch mode doesn't support klee|crest|coverage-test extension";
+		return true;
+	}
+	if (!CGOptions::delta_monitor().empty() || !CGOptions::go_delta().empty()) {
+		conflict_msg_ = "batch mode doesn't support delta options";
+		return true;
+	}
+	return false;
+}
+
+/*
+ * The fork server forks a child of the initialized process for each seed,
+ * so nothing that depends on the seed may happen before the fork.
+ */
+bool
+CGOptions::has_fork_server_conflict()
+{
+	if (!CGOptions::fork_server())
+		return false;
+
+	if (CGOptions::batch_output_dir().empty()) {
+		conflict_msg_ = "--fork-server requires --output-dir";
+		return true;
+	}
+	if (CGOptions::batch_count() > 1) {
+		conflict_msg_ = "--fork-server cannot be used with --count or --seed-range";
+		return true;
+	}
+	if (CGOptions::dfs_exhaustive()) {
+		conflict_msg_ = "--fork-server cannot be used with --dfs-exhaustive";
+		return true;
+	}
+	if (CGOptions::random_random()) {
+		conflict_msg_ = "--fork-server cannot be used with --random-random";
+		return true;
+	}
+	if (CGOptions::max_split_files() > 0) {
+		conflict_msg_ = "--fork-server cannot be used with --max-split-files";
+		return true;
+	}
+	if (!CGOptions::delta_monitor().empty() || !CGOptions::go_delta().empty()) {
+		conflict_msg_ = "--fork-server doesn't support delta options";
+		return true;
+	}
+	return false;
+}
+
+/*
+ * With --archive, the programs are written to the archive only.
+ */
+bool
+CGOptions::has_archive_conflict()
+{
+	if (CGOptions::archive_file().empty()) {
+		if (CGOptions::archive_extract()) {
+			conflict_msg_ = "--extract requires --archive";
+			return true;
+		}
+		return false;
+	}
+	if (CGOptions::archive_extract()) {
+		if (CGOptions::batch_count() > 1) {
+			conflict_msg_ = "--extract cannot be used with --count or --seed-range";
+			return true;
+		}
+		return false;
+	}
+
+	if (!CGOptions::batch_output_dir().empty()) {
+		conflict_msg_ = "--archive cannot be used with --output-dir";
+		return true;
+	}
+	if (!CGOptions::output_file().empty()) {
+		conflict_msg_ = "--archive cannot be used with --output";
+		return true;
+	}
+	if (CGOptions::fork_server()) {
+		conflict_msg_ = "--archive cannot be used with --fork-server";
+		return true;
+	}
+	if (CGOptions::dfs_exhaustive()) {
+		conflict_msg_ = "--archive cannot be used with --dfs-exhaustive";
+		return true;
+	}
+	if (CGOptions::max_split_files() > 0) {
+		conflict_msg_ = "--archive cannot be used with --max-split-files";
+		return true;
+	}
+	return false;
+}
+
 bool
 CGOptions::has_extension_support()
 {
@@ -524,6 +731,20 @@ CGOptions::has_conflict(void)
 	if (CGOptions::has_delta_conflict())
 		return true;
 
+	if (CGOptions::has_batch_conflict())
+		return true;
+
+	if (CGOptions::has_fork_server_conflict())
+		return true;
+
+	if (CGOptions::has_archive_conflict())
+		return true;
+
+	if (CGOptions::rng() != "rand48" && CGOptions::rng() != "xoshiro256") {
+		conflict_msg_ = "--rng must be rand48 or xoshiro256";
+		return true;
+	}
+
 	if ((CGOptions::inline_function_prob() < 0) ||
 	    (CGOptions::inline_function_prob() > 100)) {
 		conflict_msg_ = "inline-function-prob value must between [0,100]";
@@ -570,6 +791,23 @@ CGOptions::has_conflict(void)
 		return true;
 	}
 
+	if (CGOptions::math_builtins() && CGOptions::math_notmp()) {
+		conflict_msg_ = "--math-builtins cannot be used with --math-notmp";
+		return true;
+	}
+
+	if (CGOptions::self_contained() && (CGOptions::max_split_files() > 0 || CGOptions::dfs_exhaustive())) {
+		conflict_msg_ = "--self-contained cannot be used with --max-split-files or --dfs-exhaustive";
+		return true;
+	}
+
+	if (CGOptions::crc_algorithm() != "crc32" &&
+	    CGOptions::crc_algorithm() != "slice8" &&
+	    CGOptions::crc_algorithm() != "crc32c") {
+		conflict_msg_ = "--crc must be one of crc32, slice8 or crc32c";
+		return true;
+	}
+
 #if 0
 	Probabilities *prob = Probabilities::GetInstance();
 	if (!(CGOptions::dump_default_probabilities().empty()))
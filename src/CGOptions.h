@@ -62,7 +62,12 @@ using namespace std;
 #define CGOPTIONS_DEFAULT_MAX_SPLIT_FILES	(0)
 #define CGOPTIONS_DEFAULT_SPLIT_FILES_DIR	("./output")
 #define CGOPTIONS_DEFAULT_OUTPUT_FILE		("")
+#define CGOPTIONS_DEFAULT_CRC_ALGORITHM		("crc32")
 #define CGOPTIONS_DEFAULT_TEMP_FILE		("")
+// 1 means we generate a single program, as usual
+#define CGOPTIONS_DEFAULT_BATCH_COUNT		(1)
+// 1 means the programs of a batch are generated one after another
+#define CGOPTIONS_DEFAULT_BATCH_JOBS		(1)
 #define PLATFORM_CONFIG_FILE                ("platform.info")
 
 /*
@@ -73,6 +78,9 @@ public:
 	static bool compute_hash(void);
 	static bool compute_hash(bool p);
 
+	static std::string crc_algorithm(void);
+	static std::string crc_algorithm(std::string p);
+
 	static bool depth_protect(void);
 	static bool depth_protect(bool p);
 
@@ -88,6 +96,33 @@ public:
 	static std::string temp_file(void);
 	static std::string temp_file(std::string p);
 
+	static int batch_count(void);
+	static int batch_count(int p);
+
+	static std::string batch_output_dir(void);
+	static std::string batch_output_dir(std::string p);
+
+	static int batch_jobs(void);
+	static int batch_jobs(int p);
+
+	static bool fork_server(void);
+	static bool fork_server(bool p);
+
+	static bool rejection_sampling(void);
+	static bool rejection_sampling(bool p);
+
+	static std::string rng(void);
+	static std::string rng(std::string p);
+
+	static std::string archive_file(void);
+	static std::string archive_file(std::string p);
+
+	static bool archive_extract(void);
+	static bool archive_extract(bool p);
+
+	static std::string dedup_file(void);
+	static std::string dedup_file(std::string p);
+
 	static int max_funcs(void);
 	static int max_funcs(int p);
 
@@ -179,6 +214,9 @@ public:
 	static int max_exhaustive_depth(void);
 	static int max_exhaustive_depth(int p);
 
+	static bool dfs_checkpoint(void);
+	static bool dfs_checkpoint(bool p);
+
 	static bool compact_output(void);
 	static bool compact_output(bool p);
 
@@ -236,6 +274,12 @@ public:
 	static bool math_notmp(void);
 	static bool math_notmp(bool p);
 
+	static bool math_builtins(void);
+	static bool math_builtins(bool p);
+
+	static bool self_contained(void);
+	static bool self_contained(bool p);
+
 	static bool math64(void);
 	static bool math64(bool p);
 
@@ -341,6 +385,9 @@ public:
 	static bool step_hash_by_stmt(void);
 	static bool step_hash_by_stmt(bool p);
 
+	static bool step_hash_by_effect(void);
+	static bool step_hash_by_effect(bool p);
+
 	static bool blind_check_global(void);
 	static bool blind_check_global(bool p);
 
@@ -358,6 +405,9 @@ public:
 	static bool hash_value_printf(void);
 	static bool hash_value_printf(bool p);
 
+	static bool bulk_array_hash(void);
+	static bool bulk_array_hash(bool p);
+
 	static bool signed_char_index(void);
 	static bool signed_char_index(bool p);
 
@@ -377,6 +427,15 @@ public:
 	static bool match_exact_qualifiers(void);
 	static bool match_exact_qualifiers(bool p);
 
+	// The options are shared by all generator threads and must not change
+	// once they are parsed.  These per-thread flags temporarily override
+	// match_exact_qualifiers and access_once during generation instead.
+	static bool force_exact_qualifiers(void);
+	static bool force_exact_qualifiers(bool p);
+
+	static bool suppress_access_once(void);
+	static bool suppress_access_once(bool p);
+
 	static int max_array_num_in_loop();
 	static int max_array_num_in_loop(int p);
 
@@ -497,16 +556,32 @@ private:
 
 	static bool has_extension_conflict();
 
+	static bool has_batch_conflict();
+
+	static bool has_fork_server_conflict();
+
+	static bool has_archive_conflict();
+
 	static void parse_string_options(string vname, vector<std::string> &v);
 
 	// Until I do this right, just make them all static.
 	static bool	compute_hash_;
+	static std::string	crc_algorithm_;
 	static bool	depth_protect_;
 	static int	max_funcs_;
 	static int	max_split_files_;
 	static std::string split_files_dir_;
 	static std::string output_file_;
 	static std::string temp_file_;
+	static int	batch_count_;
+	static std::string batch_output_dir_;
+	static int	batch_jobs_;
+	static bool	fork_server_;
+	static bool	rejection_sampling_;
+	static std::string rng_;
+	static std::string archive_file_;
+	static bool	archive_extract_;
+	static std::string dedup_file_;
 	static int	max_params_;
 	static int	max_block_size_;
 	static int	max_blk_depth_;
@@ -534,11 +609,13 @@ private:
 	static bool compound_assignment_;
 	static int stop_by_stmt_;
 	static bool step_hash_by_stmt_;
+	static bool step_hash_by_effect_;
 	static bool blind_check_global_;
 	static bool	random_based_;
 	static bool	dfs_exhaustive_;
 	static std::string dfs_debug_sequence_;
 	static int	max_exhaustive_depth_;
+	static bool	dfs_checkpoint_;
 	static bool	compact_output_;
 	static int	func1_max_params_;
 	static bool	klee_;
@@ -560,6 +637,8 @@ private:
 	static bool	math64_;
 	static bool	inline_function_;
 	static bool	math_notmp_;
+	static bool	math_builtins_;
+	static bool	self_contained_;
 	static bool	longlong_;
 	static bool	int8_;
 	static bool	uint8_;
@@ -593,6 +672,7 @@ private:
 	static bool const_as_condition_;
 	static bool no_return_dead_ptr_;
 	static bool hash_value_printf_;
+	static bool bulk_array_hash_;
 	static bool signed_char_index_;
 	static std::string	dump_default_probabilities_;
 	static std::string	dump_random_probabilities_;
@@ -600,6 +680,8 @@ private:
 
 	static std::string conflict_msg_;
 	static bool match_exact_qualifiers_;
+	static thread_local bool force_exact_qualifiers_;
+	static thread_local bool suppress_access_once_;
 
 	static int max_array_num_in_loop_;
 	static bool identify_wrappers_;
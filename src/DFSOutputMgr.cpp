@@ -115,7 +115,7 @@ void
 DFSOutputMgr::outputln(ostream &out)
 {
 	if (!CGOptions::compact_output())
-		out << std::endl;
+		out << '\n';
 }
 
 void
@@ -45,6 +45,8 @@
 #include "VariableSelector.h"
 #include "util.h"
 #include "PartialExpander.h"
+#include "StatementGoto.h"
+#include "Arena.h"
 
 using namespace std;
 
@@ -89,6 +91,7 @@ DFSProgramGenerator::goGenerator()
 	//unsigned long long count = 0;
 	GenerateAllTypes();
 	output_mgr_->OutputStructUnions(cout);
+	impl->enable_checkpoints(&good_count_);
 	while(!impl->get_all_done()) {
 		Error::set_error(SUCCESS);
 		GenerateFunctions();
@@ -101,9 +104,12 @@ DFSProgramGenerator::goGenerator()
 			OutputMgr::really_outputln(cout);
 			good_count_++;
 		}
+		impl->end_run();
 		impl->reset_state();
 		Function::doFinalization();
 		VariableSelector::doFinalization();
+		StatementGoto::doFinalization();
+		Arena::program_arena().reset();
 		reset_gensym();
 		PartialExpander::restore_init_values();
 		//cout << "count = " << count << std::endl;
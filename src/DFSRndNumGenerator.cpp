@@ -34,6 +34,8 @@
 #include "DFSRndNumGenerator.h"
 
 #include <cassert>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <sstream>
 
@@ -43,6 +45,7 @@
 #include "Sequence.h"
 #include "Error.h"
 #include "SequenceLineParser.h"
+#include "platform.h"
 
 // Represents the data for each random choice
 class DFSRndNumGenerator::SearchState
@@ -140,7 +143,10 @@ DFSRndNumGenerator::DFSRndNumGenerator(Sequence *concrete_seq)
 	  current_pos_(-1),
 	  all_done_(false),
 	  seq_(concrete_seq),
-	  use_debug_sequence_(false)
+	  use_debug_sequence_(false),
+	  use_checkpoints_(false),
+	  state_fd_(-1),
+	  program_count_(NULL)
 {
 	init_states(CGOptions::max_exhaustive_depth());
 }
@@ -306,6 +312,9 @@ DFSRndNumGenerator::random_choice (int bound, const Filter *filter, const string
 		return -1;
 	}
 
+	if (use_checkpoints_ && !checkpoint(current_pos_))
+		return -1;
+
 	DFSRndNumGenerator::SearchState *state = states_[current_pos_];
 
 	state->set_bound(bound);
@@ -402,6 +411,114 @@ DFSRndNumGenerator::log_depth(int d, const string *where, const char *log)
 	trace_string_ += ss1.str();
 }
 
+/*
+ * Snapshot the generator before it makes the choice at <pos>: fork a child
+ * which goes on with the current run, and wait for the search states it
+ * reaches at the end of its run.  Every later run shares the prefix up to
+ * <pos> as long as the decision depth doesn't drop below it, so instead of
+ * regenerating that prefix from scratch, we take over the states and make
+ * the choice at <pos> again from here, behind a new snapshot.
+ * Return false if this checkpoint can't resume the search: the run is then
+ * ended with a backtracking error, and the states are passed on to the
+ * process holding the checkpoint above (see end_run).
+ */
+bool
+DFSRndNumGenerator::checkpoint(int pos)
+{
+	while (true) {
+		std::cout.flush();
+		fflush(stdout);
+
+		int fds[2];
+		if (!platform_pipe(fds))
+			return true;
+		long pid = platform_fork();
+		if (pid < 0) {
+			platform_close(fds[0]);
+			platform_close(fds[1]);
+			return true;
+		}
+		if (pid == 0) {
+			platform_close(fds[0]);
+			if (state_fd_ != -1)
+				platform_close(state_fd_);
+			state_fd_ = fds[1];
+			return true;
+		}
+
+		platform_close(fds[1]);
+		bool ok = receive_state(fds[0]);
+		platform_close(fds[0]);
+		if (!platform_wait(pid) || !ok) {
+			if (state_fd_ == -1)
+				cerr << "error: DFS checkpoint at " << pos << " failed" << std::endl;
+			exit(1);
+		}
+
+		if (all_done_ || decision_depth_ < pos) {
+			Error::set_error(BACKTRACKING_ERROR);
+			return false;
+		}
+	}
+}
+
+/*
+ * Called at the end of each run.  A process forked by checkpoint() hands
+ * the search states over to its parent and exits.
+ */
+void
+DFSRndNumGenerator::end_run(void)
+{
+	if (state_fd_ == -1)
+		return;
+	std::cout.flush();
+	fflush(stdout);
+	bool ok = send_state(state_fd_);
+	exit(ok ? 0 : 1);
+}
+
+bool
+DFSRndNumGenerator::send_state(int fd)
+{
+	std::vector<INT64> buf;
+	buf.push_back(all_done_);
+	buf.push_back(decision_depth_);
+	buf.push_back(program_count_ ? *program_count_ : 0);
+	std::vector<DFSRndNumGenerator::SearchState *>::iterator i;
+	for (i = states_.begin(); i != states_.end(); ++i) {
+		buf.push_back((*i)->init());
+		buf.push_back((*i)->value());
+		buf.push_back((*i)->bound());
+	}
+	return platform_write(fd, &buf[0], buf.size() * sizeof(INT64));
+}
+
+bool
+DFSRndNumGenerator::receive_state(int fd)
+{
+	std::vector<INT64> buf(3 + 3 * states_.size());
+	if (!platform_read(fd, &buf[0], buf.size() * sizeof(INT64)))
+		return false;
+	all_done_ = buf[0];
+	decision_depth_ = buf[1];
+	if (program_count_)
+		*program_count_ = buf[2];
+	for (size_t i = 0; i < states_.size(); ++i)
+		states_[i]->initSearchState(buf[3 + 3 * i], buf[4 + 3 * i], buf[5 + 3 * i]);
+	return true;
+}
+
+/*
+ * Start checkpointing the search, if enabled. <count> is the number of
+ * programs generated so far, which is handed back along with the states.
+ */
+void
+DFSRndNumGenerator::enable_checkpoints(INT64 *count)
+{
+	use_checkpoints_ = CGOptions::dfs_checkpoint() && !use_debug_sequence_;
+	program_count_ = count;
+}
+
 void
 DFSRndNumGenerator::init_states(int size)
 {
@@ -431,6 +548,12 @@ DFSRndNumGenerator::get_sequence(std::string &sequence)
 	sequence = ss.str();
 }
 
+void
+DFSRndNumGenerator::get_sequence(SequenceWriter &writer)
+{
+	seq_->get_sequence(writer);
+}
+
 std::string
 DFSRndNumGenerator::get_prefixed_name(const std::string &name)
 {
@@ -53,6 +53,8 @@ public:
 
 	virtual void get_sequence(std::string &sequence);
 
+	virtual void get_sequence(SequenceWriter &writer);
+
 	virtual unsigned int rnd_upto(const unsigned int n, const Filter *f = NULL, const std::string *where = NULL);
 
 	virtual bool rnd_flipcoin(const unsigned int p, const Filter *f = NULL, const std::string *where = NULL);
@@ -75,6 +77,10 @@ public:
 
 	bool get_all_done(void) { return all_done_; }
 
+	void enable_checkpoints(INT64 *count);
+
+	void end_run(void);
+
 private:
 	// Forward declaration of nested class SearchState;
 	class SearchState;
@@ -99,6 +105,12 @@ private:
 
 	void log_depth(int d, const std::string *where = NULL, const char *log = NULL);
 
+	bool checkpoint(int pos);
+
+	bool send_state(int fd);
+
+	bool receive_state(int fd);
+
 	// ----------------------------------------------------------------------------------------
 	static DFSRndNumGenerator *impl_;
 
@@ -119,6 +131,18 @@ private:
 
 	bool use_debug_sequence_;
 
+	// Whether random_choice forks a snapshot of the generator at each
+	// decision point. See checkpoint().
+	bool use_checkpoints_;
+
+	// The pipe to the process holding the checkpoint just above this one,
+	// or -1 in the top process.
+	int state_fd_;
+
+	// The number of programs generated so far, sent along with the search
+	// states.
+	INT64 *program_count_;
+
 	// Holds the vector representation of all DFS nodes.
 	std::vector<SearchState*> states_;
 
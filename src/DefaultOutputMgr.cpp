@@ -34,6 +34,8 @@
 #include "DefaultOutputMgr.h"
 
 #include <cassert>
+#include <cstdio>
+#include <iostream>
 #include <sstream>
 #include "Common.h"
 #include "CGOptions.h"
@@ -46,6 +48,8 @@
 #include "Type.h"
 #include "random.h"
 #include "Error.h"
+#include "ProgramArchive.h"
+#include "ProgramHashSet.h"
 
 static std::string filename_prefix = "rnd_output";
 
@@ -59,7 +63,7 @@ static std::string dir_sep = "\\";
 
 using namespace std;
 
-DefaultOutputMgr *DefaultOutputMgr::instance_ = NULL;
+thread_local DefaultOutputMgr *DefaultOutputMgr::instance_ = NULL;
 
 DefaultOutputMgr *
 DefaultOutputMgr::CreateInstance()
@@ -69,24 +73,41 @@ DefaultOutputMgr::CreateInstance()
 
 	std::string ofile_str = CGOptions::output_file();
 	if (!ofile_str.empty()) {
-		ofstream *ofile = new ofstream(ofile_str.c_str());
+		Emitter *ofile = new Emitter(ofile_str);
 		DefaultOutputMgr::instance_ = new DefaultOutputMgr(ofile);
 	}
 	else {
 		DefaultOutputMgr::instance_ = new DefaultOutputMgr();
 	}
 	// DefaultOutputMgr::instance_ = new DefaultOutputMgr();
+	if (!CGOptions::archive_file().empty() || !CGOptions::dedup_file().empty()
+		|| CGOptions::self_contained())
+		DefaultOutputMgr::instance_->program_out_ = new std::ostringstream();
 	assert(DefaultOutputMgr::instance_);
 	DefaultOutputMgr::instance_->init();
 	return DefaultOutputMgr::instance_;
 }
 
-ofstream *
+DefaultOutputMgr *
+DefaultOutputMgr::GetInstance()
+{
+	assert(DefaultOutputMgr::instance_);
+	return DefaultOutputMgr::instance_;
+}
+
+void
+DefaultOutputMgr::DestroyInstance()
+{
+	delete DefaultOutputMgr::instance_;
+	DefaultOutputMgr::instance_ = NULL;
+}
+
+Emitter *
 DefaultOutputMgr::open_one_output_file(int num)
 {
 	std::ostringstream ss;
 	ss << CGOptions::split_files_dir() << dir_sep << filename_prefix << num << ".c";
-	ofstream *ofile = new ofstream(ss.str().c_str());
+	Emitter *ofile = new Emitter(ss.str());
 	return ofile;
 }
 
@@ -99,7 +120,7 @@ DefaultOutputMgr::init()
 		return;
 
 	for (int i = 0; i < max_files; ++i) {
-		ofstream *out = open_one_output_file(i);
+		Emitter *out = open_one_output_file(i);
 		outs.push_back(out);
 	}
 }
@@ -116,7 +137,7 @@ DefaultOutputMgr::OutputGlobals()
 	std::ostringstream ss;
 	ss << CGOptions::split_files_dir() << dir_sep << global_header << ".h";
 
-	ofstream ofile(ss.str().c_str());
+	Emitter ofile(ss.str());
 	ofile << "#ifndef RND_GLOBALS_H" << std::endl;
 	ofile << "#define RND_GLOBALS_H" << std::endl;
 	ofile << "#include \"safe_math.h\"" << std::endl;
@@ -133,7 +154,7 @@ void
 DefaultOutputMgr::OutputAllHeaders()
 {
 	for (unsigned i = 1; i < outs.size(); ++i) {
-		ofstream *out = outs[i];
+		Emitter *out = outs[i];
 		*out << "#include <stdint.h>" << std::endl;
 
 		if (CGOptions::paranoid())
@@ -146,9 +167,9 @@ DefaultOutputMgr::OutputAllHeaders()
 
 	*outs[0] << "#include \"" << global_header << ".h\"" << std::endl;
 
-	vector<ofstream *>::iterator j;
+	vector<Emitter *>::iterator j;
 	for (j = outs.begin(); j != outs.end(); ++j) {
-		ofstream *out = (*j);
+		Emitter *out = (*j);
 		string prefix = "extern ";
 		// OutputGlobalVariablesDecls(*out, prefix);
 		OutputForwardDeclarations(*out);
@@ -190,10 +211,50 @@ DefaultOutputMgr::RandomOutputDefs()
 	RandomOutputFuncDefs();
 }
 
+/*
+ * In the batch mode, switch to the output file of the program generated
+ * with <seed> if an output directory is given.  Otherwise all programs
+ * are written to the same stream, one after another.
+ */
+void
+DefaultOutputMgr::OutputBatchBegin(unsigned long seed)
+{
+	std::string dir = CGOptions::batch_output_dir();
+	if (dir.empty())
+		return;
+
+	if (ofile_) {
+		ofile_->close();
+		delete ofile_;
+	}
+	std::ostringstream ss;
+	ss << dir << dir_sep << seed << ".c";
+	ofile_name_ = ss.str();
+	ofile_ = new Emitter(ofile_name_);
+}
+
+/*
+ * Write out what is buffered for the output files.  Done after each part
+ * of a program, so that the output is complete and in order with whatever
+ * else is printed to stdout in between.
+ */
+void
+DefaultOutputMgr::flush_outputs()
+{
+	ofile_->flush_buffer();
+	std::vector<Emitter *>::iterator i;
+	for (i = outs.begin(); i != outs.end(); ++i)
+		(*i)->flush_buffer();
+}
+
 void
 DefaultOutputMgr::OutputHeader(int argc, char *argv[], unsigned long seed)
 {
+	program_seed_ = seed;
 	OutputMgr::OutputHeader(argc, argv, seed);
+	if (program_out_)
+		header_length_ = program_out_->str().size();
+	flush_outputs();
 }
 
 void
@@ -219,6 +280,46 @@ DefaultOutputMgr::Output()
 	if (!CGOptions::nomain())
 		OutputMain(out);
 	OutputTail(out);
+	if (program_out_)
+		output_program_text();
+	flush_outputs();
+}
+
+/*
+ * Write the program kept in memory to the archive or the output file,
+ * unless --dedup finds that it is the same as an earlier one apart from
+ * the header.  With --self-contained, the runtime is copied into the
+ * program here, after it has been compared.
+ */
+void
+DefaultOutputMgr::output_program_text()
+{
+	std::string text = program_out_->str();
+	program_out_->str("");
+
+	ProgramHashSet *hashes = ProgramHashSet::GetInstance();
+	if (hashes) {
+		assert(header_length_ <= text.size());
+		uint64_t h = ProgramArchive::hash(text.data() + header_length_, text.size() - header_length_);
+		if (!hashes->insert(h)) {
+			cerr << "seed " << program_seed_ << ": duplicate program, skipped" << std::endl;
+			if (!ofile_name_.empty()) {
+				ofile_->close();
+				remove(ofile_name_.c_str());
+			}
+			return;
+		}
+	}
+
+	if (CGOptions::self_contained())
+		OutputMgr::InlineRuntime(text);
+
+	if (!CGOptions::archive_file().empty()) {
+		if (!ProgramArchive::GetInstance()->append(program_seed_, text))
+			cerr << "error: can't write seed " << program_seed_ << " to archive " << CGOptions::archive_file() << std::endl;
+	}
+	else
+		*ofile_ << text;
 }
 
 std::ostream &
@@ -226,12 +327,10 @@ DefaultOutputMgr::get_main_out()
 {
 	if (is_split())
 		return *(outs[0]);
-	else if (ofile_) {
+	else if (program_out_)
+		return *program_out_;
+	else
 		return *ofile_;
-	}
-	else {
-		return std::cout;
-	}
 }
 
 bool
@@ -243,7 +342,7 @@ DefaultOutputMgr::is_split()
 void
 DefaultOutputMgr::outputln(ostream &out)
 {
-	out << std::endl;
+	out << '\n';
 }
 
 void
@@ -259,28 +358,34 @@ DefaultOutputMgr::output_tab(ostream &out, int indent)
 }
 
 //////////////////////////////////////////////////////////////////
-DefaultOutputMgr::DefaultOutputMgr(std::ofstream *ofile)
-	: ofile_(ofile)
+DefaultOutputMgr::DefaultOutputMgr(Emitter *ofile)
+	: ofile_(ofile),
+	  program_out_(NULL),
+	  program_seed_(0),
+	  header_length_(0)
 {
 
 }
 
 DefaultOutputMgr::DefaultOutputMgr()
-	: ofile_(NULL)
+	: ofile_(new Emitter(fileno(stdout))),
+	  program_out_(NULL),
+	  program_seed_(0),
+	  header_length_(0)
 {
 
 }
 
 DefaultOutputMgr::~DefaultOutputMgr()
 {
-	std::vector<std::ofstream *>::iterator out;
+	std::vector<Emitter *>::iterator out;
 	for (out = outs.begin(); out != outs.end(); ++out) {
 		(*out)->close();
 		delete (*out);
 	}
 	outs.clear();
-	if (ofile_)
-		ofile_->close();
+	ofile_->close();
 	delete ofile_;
+	delete program_out_;
 }
 
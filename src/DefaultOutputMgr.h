@@ -33,8 +33,9 @@
 #include <vector>
 #include <string>
 #include <ostream>
-#include <fstream>
+#include <sstream>
 #include "OutputMgr.h"
+#include "Emitter.h"
 
 using namespace std;
 
@@ -42,10 +43,16 @@ class DefaultOutputMgr : public OutputMgr {
 public:
 	static DefaultOutputMgr *CreateInstance();
 
+	static DefaultOutputMgr *GetInstance();
+
+	static void DestroyInstance();
+
 	virtual ~DefaultOutputMgr();
 
 	static bool create_output_dir(std::string dir);
 
+	void OutputBatchBegin(unsigned long seed);
+
 	virtual void OutputHeader(int argc, char *argv[], unsigned long seed);
 
 	virtual void Output();
@@ -57,7 +64,7 @@ public:
 	virtual void output_tab(ostream &out, int indent);
 
 private:
-	explicit DefaultOutputMgr(std::ofstream *ofile);
+	explicit DefaultOutputMgr(Emitter *ofile);
 
 	DefaultOutputMgr();
 
@@ -65,10 +72,14 @@ private:
 
 	bool is_split();
 
-	std::ofstream* open_one_output_file(int num);
+	Emitter* open_one_output_file(int num);
 
 	void init();
 
+	void flush_outputs();
+
+	void output_program_text();
+
 	void OutputGlobals();
 
 	void OutputAllHeaders();
@@ -79,11 +90,22 @@ private:
 
 	void RandomOutputFuncDefs();
 
-	static DefaultOutputMgr *instance_;
+	static thread_local DefaultOutputMgr *instance_;
+
+	std::vector<Emitter* > outs;
+
+	Emitter *ofile_;
+
+	// the file opened by OutputBatchBegin
+	std::string ofile_name_;
+
+	// with --archive, --dedup or --self-contained: the text of the current program, its
+	// seed and the length of its header
+	std::ostringstream *program_out_;
 
-	std::vector<std::ofstream* > outs;
+	unsigned long program_seed_;
 
-	std::ofstream *ofile_;
+	size_t header_length_;
 };
 
 #endif // DEFAULT_OUTPUT_MGR_H
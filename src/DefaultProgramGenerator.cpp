@@ -32,8 +32,15 @@
 #endif
 
 #include "DefaultProgramGenerator.h"
+#include <algorithm>
 #include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
 #include <sstream>
+#include <thread>
+#include <vector>
 #include "RandomNumber.h"
 #include "AbsRndNumGenerator.h"
 #include "DefaultOutputMgr.h"
@@ -43,12 +50,18 @@
 #include "CGOptions.h"
 #include "SafeOpFlags.h"
 #include "ExtensionMgr.h"
+#include "PartialExpander.h"
+#include "Statement.h"
+#include "VariableSelector.h"
+#include "platform.h"
+#include "ProgramArchive.h"
+#include "ProgramHashSet.h"
+#include "SequenceFile.h"
 
 DefaultProgramGenerator::DefaultProgramGenerator(int argc, char *argv[], unsigned long seed)
 	: argc_(argc),
 	  argv_(argv),
-	  seed_(seed),
-	  output_mgr_(NULL)
+	  seed_(seed)
 {
 
 }
@@ -56,15 +69,17 @@ DefaultProgramGenerator::DefaultProgramGenerator(int argc, char *argv[], unsigne
 DefaultProgramGenerator::~DefaultProgramGenerator()
 {
 	Finalization::doFinalization();
-	delete output_mgr_;
+	DefaultOutputMgr::DestroyInstance();
+	ProgramArchive::DestroyInstance();
+	ProgramHashSet::DestroyInstance();
 }
 
 void
 DefaultProgramGenerator::initialize()
 {
 	RandomNumber::CreateInstance(rDefaultRndNumGenerator, seed_);
-	output_mgr_ = DefaultOutputMgr::CreateInstance();
-	assert(output_mgr_);
+	DefaultOutputMgr *output_mgr = DefaultOutputMgr::CreateInstance();
+	assert(output_mgr);
 
 	ExtensionMgr::CreateExtension();
 }
@@ -76,14 +91,34 @@ DefaultProgramGenerator::get_count_prefix(const std::string &)
 	return "";
 }
 
+/*
+ * Drop the program generated so far and restart the random number
+ * generator with <seed>.  Everything set up once per process (options,
+ * probabilities, extensions) is reused.
+ */
 void
-DefaultProgramGenerator::goGenerator()
+DefaultProgramGenerator::reset_for_seed(unsigned long seed)
+{
+	Finalization::doProgramFinalization();
+	RandomNumber::doFinalization();
+	RandomNumber::CreateInstance(rDefaultRndNumGenerator, seed);
+}
+
+/*
+ * Generate and output the program for <seed>.  The random number generator
+ * of the calling thread must already be seeded with it.
+ */
+void
+DefaultProgramGenerator::generate_program(unsigned long seed)
 {
-	output_mgr_->OutputHeader(argc_, argv_, seed_);
+	DefaultOutputMgr *output_mgr = DefaultOutputMgr::GetInstance();
+	output_mgr->OutputHeader(argc_, argv_, seed);
 
 	GenerateAllTypes();
 	GenerateFunctions();
-	output_mgr_->Output();
+	output_mgr->Output();
+	if (!CGOptions::delta_output().empty())
+		output_sequence();
 	if (CGOptions::identify_wrappers()) {
 		ofstream ofile;
 		ofile.open("wrapper.h");
@@ -92,3 +127,143 @@ DefaultProgramGenerator::goGenerator()
 	}
 }
 
+/*
+ * Write the random choices made for the program to the --delta-output
+ * file.
+ */
+void
+DefaultProgramGenerator::output_sequence()
+{
+	ofstream out(CGOptions::delta_output().c_str(), ios_base::out | ios_base::binary);
+	SequenceWriter writer(out);
+	get_sequence(writer);
+	if (!writer.finish())
+		cout << "error: can't write " << CGOptions::delta_output() << std::endl;
+}
+
+/*
+ * Run by each thread of a parallel batch: take the next seed of the batch
+ * until none is left.  All the generation state is thread-local, so the
+ * thread gets its own random number generator and output manager.
+ */
+void
+DefaultProgramGenerator::generate_worker(std::atomic<unsigned long> *next, unsigned long count)
+{
+	DefaultOutputMgr *output_mgr = DefaultOutputMgr::CreateInstance();
+	PartialExpander::restore_init_values();
+
+	for (unsigned long i = (*next)++; i < count; i = (*next)++) {
+		unsigned long seed = seed_ + i;
+		RandomNumber::CreateInstance(rDefaultRndNumGenerator, seed);
+		output_mgr->OutputBatchBegin(seed);
+		generate_program(seed);
+		Finalization::doProgramFinalization();
+		RandomNumber::doFinalization();
+	}
+	DefaultOutputMgr::DestroyInstance();
+}
+
+/*
+ * Generate the <count> programs of the batch in CGOptions::batch_jobs()
+ * threads.  Options, probabilities and the tables built from them are
+ * shared, and only read by the threads.
+ */
+void
+DefaultProgramGenerator::generate_parallel(unsigned long count)
+{
+	// These are built lazily, so build them before the threads start.
+	Statement::InitProbabilityTable();
+	VariableSelector::InitScopeTable();
+
+	std::atomic<unsigned long> next(0);
+	unsigned long jobs = std::min<unsigned long>(CGOptions::batch_jobs(), count);
+	std::vector<std::thread> threads;
+	for (unsigned long i = 0; i < jobs; ++i)
+		threads.push_back(std::thread(&DefaultProgramGenerator::generate_worker, this, &next, count));
+	for (size_t i = 0; i < threads.size(); ++i)
+		threads[i].join();
+}
+
+/*
+ * Read seeds from stdin, one per line, and generate the program for each
+ * seed in a child forked from this process, so that the initialization
+ * done so far is shared copy-on-write instead of redone for every program.
+ * The children write the programs to the output directory, and their
+ * stdout goes to stderr: stdout only has one "<seed> ok|failed" line per
+ * seed.
+ */
+void
+DefaultProgramGenerator::run_fork_server()
+{
+	std::string line;
+	while (std::getline(std::cin, line)) {
+		unsigned long seed;
+		if (sscanf(line.c_str(), "%lu", &seed) != 1) {
+			cout << "error: invalid seed " << line << std::endl;
+			continue;
+		}
+
+		long pid = platform_fork();
+		if (pid == 0) {
+			std::cout.rdbuf(std::cerr.rdbuf());
+			reset_for_seed(seed);
+			DefaultOutputMgr::GetInstance()->OutputBatchBegin(seed);
+			generate_program(seed);
+			DefaultOutputMgr::DestroyInstance();
+			// exit() would also rewind the shared stdin offset to what
+			// this child has consumed, so flush our own output and leave.
+			std::cout.flush();
+			std::cerr.flush();
+			fflush(stdout);
+			fflush(stderr);
+			platform_exit(0);
+		}
+
+		bool ok = (pid > 0) && platform_wait(pid);
+		cout << seed << (ok ? " ok" : " failed") << std::endl;
+	}
+}
+
+void
+DefaultProgramGenerator::goGenerator()
+{
+	unsigned long count = CGOptions::batch_count();
+	if ((count > 1 || CGOptions::fork_server()) && !CGOptions::batch_output_dir().empty()) {
+		if (!DefaultOutputMgr::create_output_dir(CGOptions::batch_output_dir())) {
+			cout << "error: can't create output directory " << CGOptions::batch_output_dir() << std::endl;
+			return;
+		}
+	}
+	if (!CGOptions::archive_file().empty()) {
+		if (!ProgramArchive::CreateInstance(CGOptions::archive_file(), argc_, argv_)) {
+			cout << "error: can't create archive " << CGOptions::archive_file() << std::endl;
+			return;
+		}
+	}
+	if (!CGOptions::dedup_file().empty()) {
+		if (!ProgramHashSet::CreateInstance(CGOptions::dedup_file())) {
+			cout << "error: can't use hash set " << CGOptions::dedup_file() << std::endl;
+			return;
+		}
+	}
+
+	if (CGOptions::fork_server()) {
+		run_fork_server();
+		return;
+	}
+
+	if (count > 1 && CGOptions::batch_jobs() > 1) {
+		generate_parallel(count);
+		return;
+	}
+
+	DefaultOutputMgr *output_mgr = DefaultOutputMgr::GetInstance();
+	for (unsigned long i = 0; i < count; ++i) {
+		unsigned long seed = seed_ + i;
+		if (i > 0)
+			reset_for_seed(seed);
+		if (count > 1)
+			output_mgr->OutputBatchBegin(seed);
+		generate_program(seed);
+	}
+}
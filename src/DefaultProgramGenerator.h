@@ -30,9 +30,9 @@
 #ifndef DEFAULT_PROGRAM_GENERATOR_H
 #define DEFAULT_PROGRAM_GENERATOR_H
 
+#include <atomic>
 #include "AbsProgramGenerator.h"
-
-class OutputMgr;
+#include "DefaultOutputMgr.h"
 
 class DefaultProgramGenerator : public AbsProgramGenerator {
 public:
@@ -40,7 +40,7 @@ public:
 
 	virtual ~DefaultProgramGenerator();
 
-	virtual OutputMgr* getOutputMgr() { return output_mgr_; }
+	virtual OutputMgr* getOutputMgr() { return DefaultOutputMgr::GetInstance(); }
 
 	virtual void goGenerator();
 
@@ -49,13 +49,23 @@ public:
 	virtual std::string get_count_prefix(const std::string &name);
 
 private:
+	void reset_for_seed(unsigned long seed);
+
+	void generate_program(unsigned long seed);
+
+	void output_sequence();
+
+	void generate_parallel(unsigned long count);
+
+	void generate_worker(std::atomic<unsigned long> *next, unsigned long count);
+
+	void run_fork_server();
+
 	int argc_;
 
 	char **argv_;
 
 	unsigned long seed_;
-
-	OutputMgr *output_mgr_;
 };
 
 #endif
@@ -43,8 +43,9 @@
 #include "SequenceFactory.h"
 #include "Sequence.h"
 #include "CGOptions.h"
+#include "SequenceFile.h"
 
-DefaultRndNumGenerator *DefaultRndNumGenerator::impl_ = 0;
+thread_local DefaultRndNumGenerator *DefaultRndNumGenerator::impl_ = 0;
 
 /*
  *
@@ -52,7 +53,9 @@ DefaultRndNumGenerator *DefaultRndNumGenerator::impl_ = 0;
 DefaultRndNumGenerator::DefaultRndNumGenerator(const unsigned long, Sequence *concrete_seq)
 	: rand_depth_(0),
 	  trace_string_(""),
-	  seq_(concrete_seq)
+	  seq_(concrete_seq),
+	  record_(!CGOptions::delta_output().empty()),
+	  replay_(false)
 {
 	//Nothing to do
 }
@@ -63,6 +66,7 @@ DefaultRndNumGenerator::DefaultRndNumGenerator(const unsigned long, Sequence *co
 DefaultRndNumGenerator::~DefaultRndNumGenerator()
 {
 	SequenceFactory::destroy_sequences();
+	impl_ = 0;
 }
 
 /*
@@ -80,6 +84,12 @@ DefaultRndNumGenerator::make_rndnum_generator(const unsigned long seed)
 	assert(impl_);
 	//impl_->seedrand(seed);
 
+	std::string input = CGOptions::delta_input();
+	if (!input.empty() && !impl_->load_sequence(input)) {
+		cout << "error: can't read the random choices in " << input << std::endl;
+		exit(-1);
+	}
+
 	return impl_;
 }
 
@@ -94,6 +104,12 @@ DefaultRndNumGenerator::get_sequence(std::string &sequence)
 	sequence = ss.str();
 }
 
+void
+DefaultRndNumGenerator::get_sequence(SequenceWriter &writer)
+{
+	seq_->get_sequence(writer);
+}
+
 std::string
 DefaultRndNumGenerator::get_prefixed_name(const std::string &name)
 {
@@ -101,8 +117,47 @@ DefaultRndNumGenerator::get_prefixed_name(const std::string &name)
 }
 
 void
-DefaultRndNumGenerator::add_number(int, int, int)
+DefaultRndNumGenerator::add_number(int v, int bound, int k)
+{
+	if (record_)
+		seq_->add_number(v, bound, k);
+}
+
+/*
+ * Load the choices to replay from the sequence file <fname>.
+ */
+bool
+DefaultRndNumGenerator::load_sequence(const std::string &fname)
+{
+	ifstream in(fname.c_str(), ios_base::in | ios_base::binary);
+	SequenceReader reader(in);
+	unsigned int v;
+	int pos = 0;
+	while (reader.next(v))
+		seq_->add_number(v, 0, pos++);
+	replay_ = reader.good();
+	return replay_;
+}
+
+/*
+ * Get the choice in 0..(n-1) replayed at <pos> in <v>.  If the choices run
+ * out, or don't fit the program being generated (e.g. because the options
+ * differ), warn, stop replaying and return false: the caller goes back to
+ * drawing random numbers.
+ */
+bool
+DefaultRndNumGenerator::replay_number(unsigned int n, unsigned INT64 pos, unsigned int &v)
 {
+	assert(replay_);
+	if (pos < seq_->sequence_length()) {
+		v = seq_->get_number_by_pos(static_cast<int>(pos));
+		if (v < n)
+			return true;
+	}
+	cerr << "warning: the replayed choices end or don't match at " << pos
+		 << ", drawing random numbers from there on" << std::endl;
+	replay_ = false;
+	return false;
 }
 
 /*
@@ -111,32 +166,57 @@ DefaultRndNumGenerator::add_number(int, int, int)
 unsigned int
 DefaultRndNumGenerator::rnd_upto(const unsigned int n, const Filter *f, const std::string *where)
 {
-	static int g = 0;
+	static thread_local int g = 0;
 	int h = g;
 	if (h == 440)
 		BREAK_NOP;   // for debugging
-	unsigned int v = genrand() % n;
+	unsigned int v;
+	if (replay_ && replay_number(n, rand_depth_, v)) {
+		// some filters keep the last value they checked
+		if (f)
+			f->filter(v);
+		add_number(v, n, rand_depth_);
+		rand_depth_++;
+		return v;
+	}
+	v = genrand() % n;
 	unsigned INT64 local_depth = rand_depth_;
 	rand_depth_++;
 	//ofstream out("rnd.log", ios_base::app);
 	//out << g++ << ": " << v << "(" << n << ")" << endl;
 
-	if (f) {
-		while (f->filter(v)) {
-			// We could add numbers into sequence inside the previous filter.
-			// If the previous filter failed, we need to roll back the rand_depth_ here.
-			// This will also overwrite the value added in the map.
+	if (f && f->filter(v)) {
+		std::vector<unsigned int> vals;
+		if (!CGOptions::rejection_sampling() && f->get_admissible_values(n, vals)) {
+			// Rather than redrawing until a value passes, draw once more
+			// from the admissible values.  Together with the first draw
+			// this is still uniform over them, and it cannot spin when
+			// most values are filtered out.
 			rand_depth_ = local_depth+1;
-			v = genrand() % n;
-			/*out << g++ << ": " << v << "(" << n << ")" << endl;*/
+			assert(!vals.empty());
+			v = vals[genrand() % vals.size()];
+		}
+		else {
+			do {
+				// We could add numbers into sequence inside the previous filter.
+				// If the previous filter failed, we need to roll back the rand_depth_ here.
+				// This will also overwrite the value added in the map.
+				rand_depth_ = local_depth+1;
+				v = genrand() % n;
+				/*out << g++ << ": " << v << "(" << n << ")" << endl;*/
+			} while (f->filter(v));
 		}
 	}
 	//out.close();
+#ifdef DEBUG
 	if (where) {
 	std::ostringstream ss;
 		ss << *where << "->";
 	trace_string_ += ss.str();
 	}
+#else
+	(void)where;
+#endif
 	add_number(v, n, local_depth);
 	return v;
 }
@@ -150,6 +230,11 @@ DefaultRndNumGenerator::rnd_flipcoin(const unsigned int p, const Filter *f, cons
 	assert(p <= 100);
 	unsigned INT64 local_depth = rand_depth_;
 	rand_depth_++;
+	unsigned int replayed;
+	if (replay_ && replay_number(2, local_depth, replayed)) {
+		add_number(replayed, 2, local_depth);
+		return replayed == 1;
+	}
 	if (f) {
 		if (f->filter(0)) {
 			add_number(1, 2, local_depth);
@@ -192,9 +277,11 @@ DefaultRndNumGenerator::RandomHexDigits( int num )
 	std::string str;
 	const char* hex1 = AbsRndNumGenerator::get_hex1();
 	while (num--) {
-		int x = genrand() % 16;
+		unsigned int x;
+		if (!replay_ || !replay_number(16, rand_depth_, x))
+			x = genrand() % 16;
 		str += hex1[x];
-		seq_->add_number(x, 16, rand_depth_);
+		add_number(x, 16, rand_depth_);
 		rand_depth_++;
 	}
 	return str;
@@ -209,9 +296,11 @@ DefaultRndNumGenerator::RandomDigits( int num )
 	std::string str;
 	const char* dec1 = AbsRndNumGenerator::get_dec1();
 	while (num--) {
-		int x = genrand() % 10;
+		unsigned int x;
+		if (!replay_ || !replay_number(10, rand_depth_, x))
+			x = genrand() % 10;
 		str += dec1[x];
-		seq_->add_number(x, 10, rand_depth_);
+		add_number(x, 10, rand_depth_);
 		rand_depth_++;
 	}
 	return str;
@@ -51,6 +51,8 @@ public:
 
 	virtual void get_sequence(std::string &sequence);
 
+	virtual void get_sequence(SequenceWriter &writer);
+
 	virtual unsigned int rnd_upto(const unsigned int n, const Filter *f = NULL, const std::string *where = NULL);
 
 	virtual bool rnd_flipcoin(const unsigned int p, const Filter *f = NULL, const std::string *where = NULL);
@@ -70,7 +72,11 @@ private:
 
 	void add_number(int v, int bound, int k);
 
-	static DefaultRndNumGenerator *impl_;
+	bool load_sequence(const std::string &fname);
+
+	bool replay_number(unsigned int n, unsigned INT64 pos, unsigned int &v);
+
+	static thread_local DefaultRndNumGenerator *impl_;
 
 	unsigned INT64 rand_depth_;
 
@@ -78,6 +84,12 @@ private:
 
 	Sequence *seq_;
 
+	// record the choices for --delta-output
+	bool record_;
+
+	// take the choices from --delta-input
+	bool replay_;
+
 	virtual unsigned long genrand(void);
 
 	//void seedrand(unsigned long seed);
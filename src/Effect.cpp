@@ -52,26 +52,35 @@ const Effect Effect::empty_effect;
 ///////////////////////////////////////////////////////////////////////////////
 
 /*
- * Stuff that so badly wants to be rewritten using decent STL containers and
- * algorithms.
+ * Record v in a set of variables: its id, and the aggregates it is part of.
+ * A variable "matches" the aggregates that contain it (see Variable::match),
+ * so two sets overlap if they share a variable or one holds a container of a
+ * variable in the other.
  */
-static bool
-non_empty_intersection(const vector<const Variable *> &va,
-					   const vector<const Variable *> &vb)
+static void
+add_to_var_sets(const Variable *v, BitSet &vars, BitSet &containers, BitSet &unions)
 {
-	vector<const Variable *>::size_type va_len = va.size();
-	vector<const Variable *>::size_type vb_len = vb.size();
-	vector<const Variable *>::size_type i;
-	vector<const Variable *>::size_type j;
-
-	for (i = 0; i < va_len; ++i) {
-		for (j = 0; j < vb_len; ++j) {
-			if (va[i]->match(vb[j]) || vb[j]->match(va[i])) {
-				return true;
+	vars.set(v->id);
+	if (v->type) {
+		for (const Variable *p = v->field_var_of; p; p = p->field_var_of) {
+			if (p->type && p->type->is_aggregate()) {
+				containers.set(p->id);
 			}
 		}
 	}
-	return false;
+	const Variable *u = v->get_collective()->get_container_union();
+	if (u) {
+		unions.set(u->id);
+	}
+}
+
+static bool
+non_empty_intersection(const BitSet &vars_a, const BitSet &containers_a,
+					   const BitSet &vars_b, const BitSet &containers_b)
+{
+	return vars_a.intersects(vars_b)
+		|| vars_a.intersects(containers_b)
+		|| vars_b.intersects(containers_a);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -94,6 +103,12 @@ Effect::Effect(void) :
 Effect::Effect(const Effect &e) :
 	read_vars(e.read_vars),
 	write_vars(e.write_vars),
+	read_set(e.read_set),
+	write_set(e.write_set),
+	read_containers(e.read_containers),
+	write_containers(e.write_containers),
+	read_unions(e.read_unions),
+	write_unions(e.write_unions),
 	pure(e.pure),
 	side_effect_free(e.side_effect_free)
 {
@@ -120,12 +135,50 @@ Effect::operator=(const Effect &e)
 
 	read_vars = e.read_vars;
 	write_vars = e.write_vars;
+	read_set = e.read_set;
+	write_set = e.write_set;
+	read_containers = e.read_containers;
+	write_containers = e.write_containers;
+	read_unions = e.read_unions;
+	write_unions = e.write_unions;
 	pure = e.pure;
 	side_effect_free = e.side_effect_free;
 
 	return *this;
 }
 
+void
+Effect::add_read_var(const Variable *v)
+{
+	read_vars.push_back(v);
+	add_to_var_sets(v, read_set, read_containers, read_unions);
+}
+
+void
+Effect::add_write_var(const Variable *v)
+{
+	write_vars.push_back(v);
+	add_to_var_sets(v, write_set, write_containers, write_unions);
+}
+
+void
+Effect::rebuild_var_sets(void)
+{
+	size_t i;
+	read_set.clear();
+	read_containers.clear();
+	read_unions.clear();
+	for (i=0; i<read_vars.size(); i++) {
+		add_to_var_sets(read_vars[i], read_set, read_containers, read_unions);
+	}
+	write_set.clear();
+	write_containers.clear();
+	write_unions.clear();
+	for (i=0; i<write_vars.size(); i++) {
+		add_to_var_sets(write_vars[i], write_set, write_containers, write_unions);
+	}
+}
+
 /*
  *
  */
@@ -133,7 +186,7 @@ void
 Effect::read_var(const Variable *v)
 {
 	if (!is_read(v)) {
-		read_vars.push_back(v);
+		add_read_var(v);
 	}
 	pure &= (v->is_const() && !v->is_volatile() && !v->is_access_once());
 	side_effect_free &= (!v->is_volatile() && !v->is_access_once());
@@ -158,7 +211,7 @@ void
 Effect::write_var(const Variable *v)
 {
 	if (!is_written(v)) {
-		write_vars.push_back(v);
+		add_write_var(v);
 	}
 	// pure = pure;
 	// TODO: not quite correct below ---
@@ -185,8 +238,7 @@ Effect::add_effect(const Effect &e, bool include_lhs_effects)
 		return;
 	}
 
-	// Stuff that so badly wants to be rewritten using decent STL containers
-	// and algorithms... compute the union effect.
+	// compute the union effect.
 
 	vector<const Variable *>::size_type len;
 	vector<const Variable *>::size_type i;
@@ -195,14 +247,14 @@ Effect::add_effect(const Effect &e, bool include_lhs_effects)
 	for (i = 0; i < len; ++i) {
 		// this->read_var(e.read_vars[i]);
 		if (!is_read(e.read_vars[i])) {
-			this->read_vars.push_back(e.read_vars[i]);
+			add_read_var(e.read_vars[i]);
 		}
 	}
 	len = e.write_vars.size();
 	for (i = 0; i < len; ++i) {
 		// this->write_var(e.write_vars[i]);
 		if (!is_written(e.write_vars[i])) {
-			this->write_vars.push_back(e.write_vars[i]);
+			add_write_var(e.write_vars[i]);
 		}
 	}
 
@@ -308,7 +360,7 @@ Effect::add_external_effect(const Effect &e, std::vector<const Block*> call_chai
 bool
 Effect::is_read(const Variable *v) const
 {
-	if (std::find(read_vars.begin(), read_vars.end(), v) != read_vars.end()) {
+	if (read_set.test(v->id)) {
 		return true;
 	}
 
@@ -370,13 +422,8 @@ Effect::is_read(string vname) const
 bool
 Effect::is_written(const Variable *v) const
 {
-	vector<Variable *>::size_type len = write_vars.size();
-	vector<Variable *>::size_type i;
-
-	for (i = 0; i < len; ++i) {
-		if (write_vars[i] == v) {
-			return true;
-		}
+	if (write_set.test(v->id)) {
+		return true;
 	}
 	// if we write a struct/union, presumingly all the fields are written too
 	if (v->field_var_of) {
@@ -466,30 +513,14 @@ bool
 Effect::sibling_union_field_is_read(const Variable *v) const
 {
 	const Variable* you = v->get_collective()->get_container_union();
-	if (you) {
-		for (size_t i=0; i<read_vars.size(); i++) {
-			const Variable* me = read_vars[i]->get_collective()->get_container_union();
-			if (you == me) {
-				return true;
-			}
-		}
-	}
-	return false;
+	return you && read_unions.test(you->id);
 }
 
 bool
 Effect::sibling_union_field_is_written(const Variable *v) const
 {
 	const Variable* you = v->get_collective()->get_container_union();
-	if (you) {
-		for (size_t i=0; i<write_vars.size(); i++) {
-			const Variable* me = write_vars[i]->get_collective()->get_container_union();
-			if (you == me) {
-				return true;
-			}
-		}
-	}
-	return false;
+	return you && write_unions.test(you->id);
 }
 
 bool
@@ -516,6 +547,7 @@ Effect::consolidate(void)
 		const Variable* tmp = read_vars[i];
 		if (tmp->is_field_var() && is_read(tmp->field_var_of)) {
 			read_vars.erase(read_vars.begin() + i);
+			read_set.reset(tmp->id);
 			i--;
 			len--;
 		}
@@ -525,10 +557,12 @@ Effect::consolidate(void)
 		const Variable* tmp = write_vars[i];
 		if (tmp->is_field_var() && is_written(tmp->field_var_of)) {
 			write_vars.erase(write_vars.begin() + i);
+			write_set.reset(tmp->id);
 			i--;
 			len--;
 		}
 	}
+	rebuild_var_sets();
 }
 
 /*
@@ -537,9 +571,9 @@ Effect::consolidate(void)
 bool
 Effect::has_race_with(const Effect &e) const
 {
-	return (non_empty_intersection(this->read_vars,  e.write_vars)
-			|| non_empty_intersection(this->write_vars, e.read_vars)
-			|| non_empty_intersection(this->write_vars, e.write_vars));
+	return (non_empty_intersection(read_set, read_containers, e.write_set, e.write_containers)
+			|| non_empty_intersection(write_set, write_containers, e.read_set, e.read_containers)
+			|| non_empty_intersection(write_set, write_containers, e.write_set, e.write_containers));
 }
 
 /*
@@ -559,6 +593,7 @@ Effect::clear(void)
 {
 	read_vars.clear();
 	write_vars.clear();
+	rebuild_var_sets();
 	pure = side_effect_free = true;
 }
 
@@ -34,6 +34,7 @@
 
 #include <ostream>
 #include <vector>
+#include "BitSet.h"
 
 class Variable;
 class Block;
@@ -93,10 +94,23 @@ public:
 	void update_purity(void);
 
 private:
+	void add_read_var(const Variable *v);
+	void add_write_var(const Variable *v);
+	void rebuild_var_sets(void);
+
 	std::vector<const Variable *> read_vars;
 	std::vector<const Variable *> write_vars;
 	std::vector<const Variable *> lhs_write_vars;
 
+	// read_vars and write_vars again, indexed by Variable::id; and the
+	// aggregates and unions containing them, for the race and field checks
+	BitSet read_set;
+	BitSet write_set;
+	BitSet read_containers;
+	BitSet write_containers;
+	BitSet read_unions;
+	BitSet write_unions;
+
 	bool pure;
 	bool side_effect_free;
 
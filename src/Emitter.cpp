@@ -0,0 +1,179 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#if HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "Emitter.h"
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#ifndef WIN32
+#  include <unistd.h>
+#else
+#  include <io.h>
+#endif
+
+EmitterBuf::EmitterBuf()
+	: buffer_(new char[BUFFER_SIZE]),
+	  fd_(-1),
+	  owns_fd_(false)
+{
+	setp(buffer_, buffer_ + BUFFER_SIZE);
+}
+
+EmitterBuf::~EmitterBuf()
+{
+	close();
+	delete [] buffer_;
+}
+
+void
+EmitterBuf::open(int fd, bool owns_fd)
+{
+	close();
+	fd_ = fd;
+	owns_fd_ = owns_fd;
+}
+
+bool
+EmitterBuf::write_all(const char *s, std::size_t n)
+{
+	if (n == 0)
+		return true;
+	if (fd_ < 0)
+		return false;
+	// Whatever stdio has buffered for the descriptor was written first.
+	if (!owns_fd_) {
+		std::cout.flush();
+		fflush(stdout);
+	}
+	while (n > 0) {
+		long written = ::write(fd_, s, n);
+		if (written <= 0)
+			return false;
+		s += written;
+		n -= written;
+	}
+	return true;
+}
+
+bool
+EmitterBuf::flush_buffer()
+{
+	bool ok = write_all(pbase(), pptr() - pbase());
+	setp(buffer_, buffer_ + BUFFER_SIZE);
+	return ok;
+}
+
+bool
+EmitterBuf::close()
+{
+	if (fd_ < 0)
+		return true;
+	bool ok = flush_buffer();
+	if (owns_fd_ && ::close(fd_) != 0)
+		ok = false;
+	fd_ = -1;
+	return ok;
+}
+
+EmitterBuf::int_type
+EmitterBuf::overflow(int_type c)
+{
+	if (!flush_buffer())
+		return traits_type::eof();
+	if (!traits_type::eq_int_type(c, traits_type::eof())) {
+		*pptr() = traits_type::to_char_type(c);
+		pbump(1);
+	}
+	return traits_type::not_eof(c);
+}
+
+std::streamsize
+EmitterBuf::xsputn(const char *s, std::streamsize n)
+{
+	std::size_t len = static_cast<std::size_t>(n);
+	if (len > static_cast<std::size_t>(epptr() - pptr())) {
+		if (!flush_buffer())
+			return 0;
+		// too big to be worth copying
+		if (len >= BUFFER_SIZE)
+			return write_all(s, len) ? n : 0;
+	}
+	memcpy(pptr(), s, len);
+	pbump(static_cast<int>(len));
+	return n;
+}
+
+int
+EmitterBuf::sync()
+{
+	return 0;
+}
+
+//////////////////////////////////////////////////////////////////////
+Emitter::Emitter(int fd)
+	: std::ostream(NULL)
+{
+	buf_.open(fd, false);
+	rdbuf(&buf_);
+}
+
+Emitter::Emitter(const std::string &fname)
+	: std::ostream(NULL)
+{
+	int fd = ::open(fname.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+	rdbuf(&buf_);
+	if (fd >= 0)
+		buf_.open(fd, true);
+	else
+		setstate(std::ios_base::failbit);
+}
+
+Emitter::~Emitter()
+{
+	buf_.close();
+}
+
+void
+Emitter::flush_buffer()
+{
+	if (!buf_.flush_buffer())
+		setstate(std::ios_base::badbit);
+}
+
+void
+Emitter::close()
+{
+	if (!buf_.close())
+		setstate(std::ios_base::badbit);
+}
@@ -0,0 +1,106 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#ifndef EMITTER_H
+#define EMITTER_H
+
+#include <cstddef>
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+/*
+ * The stream buffer of an Emitter: a large append buffer written to a file
+ * descriptor with write(2) only when it is full or explicitly flushed.
+ *
+ * sync() deliberately does not write: the output code ends its lines with
+ * std::endl all over, and honoring each of those flushes would cost one
+ * system call per generated line.
+ */
+class EmitterBuf : public std::streambuf
+{
+public:
+	EmitterBuf();
+
+	virtual ~EmitterBuf();
+
+	void open(int fd, bool owns_fd);
+
+	bool is_open() const { return fd_ >= 0; }
+
+	bool flush_buffer();
+
+	bool close();
+
+protected:
+	virtual int_type overflow(int_type c);
+
+	virtual std::streamsize xsputn(const char *s, std::streamsize n);
+
+	virtual int sync();
+
+private:
+	bool write_all(const char *s, std::size_t n);
+
+	static const std::size_t BUFFER_SIZE = 1 << 16;
+
+	char *buffer_;
+
+	int fd_;
+
+	// false for descriptors shared with stdio, such as stdout
+	bool owns_fd_;
+};
+
+/*
+ * An output stream for generated programs.  It writes to a file it opens
+ * or to a descriptor it is given, such as stdout, and only writes when its
+ * buffer is full or on flush_buffer(), so the buffer must be flushed
+ * whenever the output has to be visible, e.g. before anything else is
+ * written to the same descriptor.
+ */
+class Emitter : public std::ostream
+{
+public:
+	explicit Emitter(int fd);
+
+	explicit Emitter(const std::string &fname);
+
+	virtual ~Emitter();
+
+	bool is_open() const { return buf_.is_open(); }
+
+	void flush_buffer();
+
+	void close();
+
+private:
+	EmitterBuf buf_;
+};
+
+#endif // EMITTER_H
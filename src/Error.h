@@ -90,7 +90,7 @@ public:
 private:
 	Error();
 	~Error();
-	static int r_error_;
+	static thread_local int r_error_;
 
 	DISALLOW_COPY_AND_ASSIGN(Error);
 };
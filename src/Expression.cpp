@@ -62,7 +62,7 @@
 #include "CVQualifiers.h"
 #include "DepthSpec.h"
 
-int eid = 0;
+static thread_local int eid = 0;
 
 DistributionTable Expression::exprTable_;
 DistributionTable Expression::paramTable_;
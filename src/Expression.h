@@ -45,6 +45,7 @@
 #include "CGContext.h"
 #include "CVQualifiers.h"
 #include "ProbabilityTable.h"
+#include "Arena.h"
 #include <vector>
 #include <string>
 using namespace std;
@@ -93,6 +94,8 @@ class ProbabilityTable;
 class Expression
 {
 public:
+	ALLOCATE_FROM_PROGRAM_ARENA
+
 	// Factory method.
 	static Expression *make_random(CGContext &cg_context, const Type* type, const CVQualifiers* qfer=0, bool no_func = false, bool no_const = false, enum eTermType tt=MAX_TERM_TYPES);
 
@@ -41,7 +41,7 @@
 #include "StatementReturn.h"
 
 using namespace std;
-std::vector<Fact*> Fact::facts_;
+thread_local std::vector<Fact*> Fact::facts_;
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -160,54 +160,165 @@ find_related_fact(const vector<Fact*>& facts, const Fact* new_fact)
     return 0;
 }
 
+/*
+ * Positions of the facts in an env, indexed by (variable id, category), so
+ * that related facts are found without scanning the env. The slot table is
+ * shared by the thread and only the slots that were filled are cleared
+ * afterwards, so building an index costs time proportional to the env, not
+ * to the number of variables. Only one index may be alive at a time.
+ */
+template <class T>
+class FactIndex
+{
+public:
+	explicit FactIndex(const vector<T*>& facts);
+	~FactIndex(void);
+
+	int find(const Fact* f) const;
+	void add(const Fact* f, int pos);
+
+private:
+	static int slot_of(const Fact* f);
+
+	const vector<T*>& facts_;
+	vector<int> used_;
+
+	// unimplemented
+	FactIndex(const FactIndex &fi);
+	FactIndex &operator=(const FactIndex &fi);
+};
+
+static thread_local vector<int> fact_index_slots;
+static thread_local bool fact_index_busy = false;
+
+template <class T>
+FactIndex<T>::FactIndex(const vector<T*>& facts)
+	: facts_(facts)
+{
+	assert(!fact_index_busy);
+	fact_index_busy = true;
+	for (size_t i=0; i<facts.size(); i++) {
+		add(facts[i], (int)i);
+	}
+}
+
+template <class T>
+FactIndex<T>::~FactIndex(void)
+{
+	for (size_t i=0; i<used_.size(); i++) {
+		fact_index_slots[used_[i]] = -1;
+	}
+	fact_index_busy = false;
+}
+
+template <class T>
+int
+FactIndex<T>::slot_of(const Fact* f)
+{
+	const Variable* v = f->get_var();
+	if (v == 0) {
+		return -1;
+	}
+	return v->id * 2 + (f->eCat == ePointTo ? 0 : 1);
+}
+
+/*
+ * return the position of the fact related to f, or -1 if there is none
+ */
+template <class T>
+int
+FactIndex<T>::find(const Fact* f) const
+{
+	int slot = slot_of(f);
+	if (slot >= 0) {
+		if ((size_t)slot >= fact_index_slots.size() || fact_index_slots[slot] < 0) {
+			return -1;
+		}
+		int pos = fact_index_slots[slot];
+		if (f->is_related(*facts_[pos])) {
+			return pos;
+		}
+	}
+	// variables without id, or ids shared by variables from different programs
+	for (size_t i=0; i<facts_.size(); i++) {
+		if (f->is_related(*facts_[i])) {
+			return (int)i;
+		}
+	}
+	return -1;
+}
+
+/*
+ * record that the fact at pos is in the env. The first fact about a variable
+ * wins, as it does with a linear scan
+ */
+template <class T>
+void
+FactIndex<T>::add(const Fact* f, int pos)
+{
+	int slot = slot_of(f);
+	if (slot < 0) {
+		return;
+	}
+	if ((size_t)slot >= fact_index_slots.size()) {
+		fact_index_slots.resize(slot + 1, -1);
+	}
+	if (fact_index_slots[slot] < 0) {
+		fact_index_slots[slot] = pos;
+		used_.push_back(slot);
+	}
+}
+
 // TODO: we really need to free the memory properly while maintain the memory in compact
 // way, i.e., don't allocate a Fact object unless it's absolutely necessary
+static bool
+merge_fact(FactVec& facts, FactIndex<const Fact>& index, const Fact* new_fact)
+{
+	int i = index.find(new_fact);
+	if (i >= 0) {
+		const Fact* f = facts[i];
+		if (!f->imply(*new_fact)) {
+			Fact* copy_fact = new_fact->clone();
+			copy_fact->join(*f);
+			facts[i] = copy_fact;
+			return true;
+		}
+		return false;
+	}
+	facts.push_back(new_fact);
+	index.add(new_fact, (int)facts.size() - 1);
+	return true;
+}
+
 bool
 merge_fact(FactVec& facts, const Fact* new_fact)
 {
-    bool changed = false;
-    size_t i;
-    for (i=0; i<facts.size(); i++) {
-        const Fact* f = facts[i];
-        if (f->is_related(*new_fact)) {
-            if (!f->imply(*new_fact)) {
-				Fact* copy_fact = new_fact->clone();
-                copy_fact->join(*f);
-                facts[i] = copy_fact;
-                changed = true;
-				// TODO: release the memory for f???
-            }
-            else {
-                //delete new_fact;   // new fact is useless, unsafe to do so???
-            }
-            break;
-        }
-    }
-    if (i == facts.size()) {// if not found
-        facts.push_back(new_fact);
-        changed = true;
-    }
-    return changed;
+	FactIndex<const Fact> index(facts);
+	return merge_fact(facts, index, new_fact);
+}
+
+static bool
+renew_fact(FactVec& facts, FactIndex<const Fact>& index, const Fact* new_fact)
+{
+	int i = index.find(new_fact);
+	if (i >= 0) {
+		if (new_fact->equal(*facts[i])) {
+			return false;
+		}
+		facts[i] = new_fact;
+		return true;
+	}
+	// if not found, append the new fact
+	facts.push_back(new_fact);
+	index.add(new_fact, (int)facts.size() - 1);
+	return true;
 }
 
 bool
 renew_fact(FactVec& facts, const Fact* new_fact)
 {
-    size_t i;
-    for (i=0; i<facts.size(); i++) {
-        if (new_fact->is_related(*facts[i])) {
-            if (new_fact->equal(*facts[i])) {
-                return false;
-            }
-            facts[i] = new_fact;
-            break;
-        }
-    }
-    // if not found, append the new fact
-    if (i==facts.size()) {
-        facts.push_back(new_fact);
-    }
-    return true;
+	FactIndex<const Fact> index(facts);
+	return renew_fact(facts, index, new_fact);
 }
 
 bool
@@ -215,9 +326,9 @@ merge_facts(FactVec& facts, const FactVec& new_facts)
 {
     size_t i;
     bool changed = false;
+	FactIndex<const Fact> index(facts);
     for (i=0; i<new_facts.size(); i++) {
-		//new_facts[i]->Output(cout);
-        if (merge_fact(facts, new_facts[i])) {
+        if (merge_fact(facts, index, new_facts[i])) {
             changed = true;
         }
     }
@@ -229,8 +340,9 @@ renew_facts(FactVec& facts, const FactVec& new_facts)
 {
     size_t i;
     bool changed = false;
+	FactIndex<const Fact> index(facts);
     for (i=0; i<new_facts.size(); i++) {
-        if (renew_fact(facts, new_facts[i])) {
+        if (renew_fact(facts, index, new_facts[i])) {
             changed = true;
         }
     }
@@ -255,15 +367,13 @@ copy_facts(const FactVec& facts_in)
 void
 combine_facts(vector<Fact*>& facts1, const FactVec& facts2)
 {
-    size_t i, j;
+    size_t i;
+	FactIndex<Fact> index(facts1);
     for (i=0; i<facts2.size(); i++) {
 		const Fact* new_fact = facts2[i];
-		for (j=0; j<facts1.size(); j++) {
-			Fact* old_fact = facts1[j];
-			if (old_fact->is_related(*new_fact)) {
-				old_fact->join_visits(*new_fact);
-				break;
-			}
+		int j = index.find(new_fact);
+		if (j >= 0) {
+			facts1[j]->join_visits(*new_fact);
 		}
 	}
 }
@@ -273,8 +383,10 @@ same_facts(const FactVec& facts1, const FactVec& facts2)
 {
 	if (facts1.size() == facts2.size()) {
 		size_t i;
+		FactIndex<const Fact> index(facts2);
 		for (i=0; i<facts1.size(); i++) {
-			if (find_fact(facts2, facts1[i]) == -1) {
+			int j = index.find(facts1[i]);
+			if (j == -1 || !facts1[i]->equal(*facts2[j])) {
 				return false;
 			}
 		}
@@ -288,10 +400,11 @@ subset_facts(const FactVec& facts1, const FactVec& facts2)
 {
 	if (facts1.size() == facts2.size()) {
 		size_t i;
+		FactIndex<const Fact> index(facts2);
 		for (i=0; i<facts1.size(); i++) {
 			const Fact* f1 = facts1[i];
-			const Fact* f2 = find_related_fact(facts2, f1);
-			if (f2 == 0 || !f2->imply(*f1)) {
+			int j = index.find(f1);
+			if (j == -1 || !facts2[j]->imply(*f1)) {
 				return false;
 			}
 		}
@@ -34,6 +34,7 @@
 
 #include <ostream>
 #include <vector>
+#include "Arena.h"
 using namespace std;
 
 enum eFactCategory {
@@ -60,6 +61,8 @@ class ExpressionVariable;
 class Fact
 {
 public:
+	ALLOCATE_FROM_PROGRAM_ARENA
+
 	Fact(eFactCategory e);
 
 	virtual ~Fact(void);
@@ -106,7 +109,7 @@ public:
 
 protected:
 	// keep track all created facts. used for releasing memory in doFinalization
-	static std::vector<Fact*> facts_;
+	static thread_local std::vector<Fact*> facts_;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
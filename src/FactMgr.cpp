@@ -66,7 +66,7 @@
 
 using namespace std;
 
-std::vector<Fact*> FactMgr::meta_facts;
+thread_local std::vector<Fact*> FactMgr::meta_facts;
 
 /*
 添加变量事实和更新事实
@@ -89,20 +89,22 @@ FactMgr::add_new_var_fact_and_update_inout_maps(const Block* blk, const Variable
 				global_facts.push_back(f);
 			}
 
-			map<const Statement*, FactVec>::iterator iter;
-			for(iter = map_facts_in.begin(); iter != map_facts_in.end(); ++iter) {
-				const Statement* stm = iter->first;
+			size_t i;
+			for (i=0; i<map_facts_in.slots(); i++) {
+				const Statement* stm = map_facts_in.stm(i);
 				if (stm && (stm->in_block(blk) || blk == NULL)) {
-					iter->second.push_back(f);
+					map_facts_in.value(i).push_back(f);
 				}
 			}
-			for(iter = map_facts_out.begin(); iter != map_facts_out.end(); ++iter) {
-				const Statement* stm = iter->first;
-				assert(stm);
+			for (i=0; i<map_facts_out.slots(); i++) {
+				const Statement* stm = map_facts_out.stm(i);
+				if (stm == 0) {
+					continue;
+				}
 				if (blk) {
 					add_fact_out(stm, f);
 				} else {
-					iter->second.push_back(f);
+					map_facts_out.value(i).push_back(f);
 				}
 			}
 		}
@@ -224,33 +226,35 @@ FactMgr::setup_in_out_maps(bool first_time)
 {
 	if (first_time) {
 		// first time revisit, create map_facts_in_final and map_facts_out_final with cloned facts
-		map<const Statement*, vector<const Fact*> >::const_iterator iter;
-		for(iter = map_facts_in.begin(); iter != map_facts_in.end(); ++iter) {
-			const Statement* stm = iter->first;
-			const vector<const Fact*>& facts1 = iter->second;
-			map_facts_in_final[stm] = copy_facts(facts1);
+		size_t i;
+		for (i=0; i<map_facts_in.slots(); i++) {
+			const Statement* stm = map_facts_in.stm(i);
+			if (stm) {
+				map_facts_in_final[stm] = copy_facts(map_facts_in.value(i));
+			}
 		}
-		for(iter = map_facts_out.begin(); iter != map_facts_out.end(); ++iter) {
-			const Statement* stm = iter->first;
-			const vector<const Fact*>& facts1 = iter->second;
-			map_facts_out_final[stm] = copy_facts(facts1);
+		for (i=0; i<map_facts_out.slots(); i++) {
+			const Statement* stm = map_facts_out.stm(i);
+			if (stm) {
+				map_facts_out_final[stm] = copy_facts(map_facts_out.value(i));
+			}
 		}
 	}
 	else {
 		// not the 1st time revisit
 		// combine facts_in and facts_out from this invocation with facts from previous invocations
-		map<const Statement*, vector<Fact*> >::iterator iter;
-		for(iter = map_facts_in_final.begin(); iter != map_facts_in_final.end(); ++iter) {
-			const Statement* stm = iter->first;
-			vector<Fact*>& facts1 = iter->second;
-			const FactVec& facts2 = map_facts_in[stm];
-			combine_facts(facts1, facts2);
+		size_t i;
+		for (i=0; i<map_facts_in_final.slots(); i++) {
+			const Statement* stm = map_facts_in_final.stm(i);
+			if (stm) {
+				combine_facts(map_facts_in_final.value(i), map_facts_in[stm]);
+			}
 		}
-		for(iter = map_facts_out_final.begin(); iter != map_facts_out_final.end(); ++iter) {
-			const Statement* stm = iter->first;
-			vector<Fact*>& facts1 = iter->second;
-			const FactVec& facts2 = map_facts_out[stm];
-			combine_facts(facts1, facts2);
+		for (i=0; i<map_facts_out_final.slots(); i++) {
+			const Statement* stm = map_facts_out_final.stm(i);
+			if (stm) {
+				combine_facts(map_facts_out_final.value(i), map_facts_out[stm]);
+			}
 		}
 	}
 	//JYTODO: beef up the sanity check
@@ -544,14 +548,13 @@ FactMgr::makeup_new_var_facts(vector<const Fact*>& old_facts, const vector<const
 void
 FactMgr::clear_map_visited(void)
 {
-	map<const Statement*, bool>::iterator iter;
-	for(iter = map_visited.begin(); iter != map_visited.end(); ++iter) {
-		iter->second = false;
+	for (size_t i=0; i<map_visited.slots(); i++) {
+		map_visited.value(i) = false;
 	}
 }
 
 void
-FactMgr::backup_stm_fact_maps(const Statement* stm, map<const Statement*, FactVec>& facts_in, map<const Statement*, FactVec>& facts_out)
+FactMgr::backup_stm_fact_maps(const Statement* stm, StatementMap<FactVec>& facts_in, StatementMap<FactVec>& facts_out)
 {
 	vector<const Block*> blks;
 	stm->get_blocks(blks);
@@ -568,7 +571,7 @@ FactMgr::backup_stm_fact_maps(const Statement* stm, map<const Statement*, FactVe
 }
 
 void
-FactMgr::restore_stm_fact_maps(const Statement* stm, map<const Statement*, FactVec>& facts_in, map<const Statement*, FactVec>& facts_out)
+FactMgr::restore_stm_fact_maps(const Statement* stm, StatementMap<FactVec>& facts_in, StatementMap<FactVec>& facts_out)
 {
 	vector<const Block*> blks;
 	stm->get_blocks(blks);
@@ -749,10 +752,11 @@ FactMgr::find_dangling_global_ptrs(Function* f)
 void
 FactMgr::sanity_check_map() const
 {
-	map<const Statement*, vector<const Fact*> >::const_iterator iter;
-	for(iter = map_facts_in.begin(); iter != map_facts_in.end(); ++iter) {
-		const Statement* stm = iter->first;
-		const vector<const Fact*>& facts = iter->second;
+	size_t j;
+	for (j=0; j<map_facts_in.slots(); j++) {
+		const Statement* stm = map_facts_in.stm(j);
+		if (stm == 0) continue;
+		const vector<const Fact*>& facts = map_facts_in.value(j);
 		for (size_t i=0; i<facts.size(); i++) {
 			const Variable* v = facts[i]->get_var();
 			if (!v->is_visible(stm->parent)) {
@@ -765,9 +769,10 @@ FactMgr::sanity_check_map() const
 		}
 	}
 
-	for(iter = map_facts_out.begin(); iter != map_facts_out.end(); ++iter) {
-		const Statement* stm = iter->first;
-		const vector<const Fact*>& facts = iter->second;
+	for (j=0; j<map_facts_out.slots(); j++) {
+		const Statement* stm = map_facts_out.stm(j);
+		if (stm == 0) continue;
+		const vector<const Fact*>& facts = map_facts_out.value(j);
 		for (size_t i=0; i<facts.size(); i++) {
 			const Variable* v = facts[i]->get_var();
 			if (!v->is_visible(stm->parent) && !func->rv->match(v)) {
@@ -787,6 +792,9 @@ FactMgr::get_program_end_facts(void)
 void
 FactMgr::doFinalization()
 {
+	// the interned facts are about to be released
+	FactPointTo::doFinalization();
+	FactUnion::doFinalization();
 	Fact::doFinalization();
 	meta_facts.clear();
 }
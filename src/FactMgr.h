@@ -58,6 +58,7 @@ class CFGEdge;
 #include <map>
 #include "Effect.h"
 #include "Fact.h"
+#include "StatementMap.h"
 using namespace std;
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -96,8 +97,8 @@ public:
 	void create_cfg_edge(const Statement* src, const Statement* dest, bool post_stm_edge, bool back_link);
 
 	void clear_map_visited(void);
-	void backup_stm_fact_maps(const Statement* stm, map<const Statement*, FactVec>& facts_in, map<const Statement*, FactVec>& facts_out);
-	void restore_stm_fact_maps(const Statement* stm, map<const Statement*, FactVec>& facts_in, map<const Statement*, FactVec>& facts_out);
+	void backup_stm_fact_maps(const Statement* stm, StatementMap<FactVec>& facts_in, StatementMap<FactVec>& facts_out);
+	void restore_stm_fact_maps(const Statement* stm, StatementMap<FactVec>& facts_in, StatementMap<FactVec>& facts_out);
 	void reset_stm_fact_maps(const Statement* stm);
 
 	void output_assertions(std::ostream &out, const Statement* stm, int indent, bool post_condition);
@@ -137,17 +138,17 @@ public:
 
 	void sanity_check_map() const;
 
-	static std::vector<Fact*> meta_facts;
+	static thread_local std::vector<Fact*> meta_facts;
 
 	// maps to track facts and effects at historical generation points.
 	// they are used for bypassing analyzing statements if possible
-	std::map<const Statement*, FactVec> map_facts_in;
-	std::map<const Statement*, FactVec> map_facts_out;
-	std::map<const Statement*, std::vector<Fact*> > map_facts_in_final;
-	std::map<const Statement*, std::vector<Fact*> > map_facts_out_final;
-	std::map<const Statement*, Effect> map_stm_effect;
-	std::map<const Statement*, Effect> map_accum_effect;
-	std::map<const Statement*, bool> map_visited;
+	StatementMap<FactVec> map_facts_in;
+	StatementMap<FactVec> map_facts_out;
+	StatementMap<std::vector<Fact*> > map_facts_in_final;
+	StatementMap<std::vector<Fact*> > map_facts_out_final;
+	StatementMap<Effect> map_stm_effect;
+	StatementMap<Effect> map_accum_effect;
+	StatementMap<bool> map_visited;
 
 	std::vector<const CFGEdge*> cfg_edges;
 	FactVec global_facts;
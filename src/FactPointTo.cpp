@@ -63,8 +63,9 @@ using namespace std;
 const Variable* FactPointTo::null_ptr = VariableSelector::make_dummy_static_variable("null");
 const Variable* FactPointTo::garbage_ptr = VariableSelector::make_dummy_static_variable("garbage");
 const Variable* FactPointTo::tbd_ptr = VariableSelector::make_dummy_static_variable("tbd");
-vector<const Variable*> FactPointTo::all_ptrs;
-vector<vector<const Variable*> > FactPointTo::all_aliases;
+thread_local vector<const Variable*> FactPointTo::all_ptrs;
+thread_local vector<vector<const Variable*> > FactPointTo::all_aliases;
+thread_local std::map<FactPointTo::InternKey, FactPointTo*> FactPointTo::interned_facts_;
 
 bool
 FactPointTo::is_null() const
@@ -316,25 +317,33 @@ FactPointTo::clone(void) const
 FactPointTo *
 FactPointTo::make_fact(const Variable *v)
 {
-	FactPointTo *fact = new FactPointTo(v);
-	facts_.push_back(fact);
-	return fact;
+	return make_fact(v, garbage_ptr);
 }
 
+/*
+ * facts returned by make_fact are interned: asking twice for the same
+ * variable and (ordered) point-to set yields the same object. They are shared
+ * between environments and must not be modified; clone() them first.
+ */
 FactPointTo *
 FactPointTo::make_fact(const Variable* v, const vector<const Variable*>& set)
 {
+	InternKey key(v, set);
+	map<InternKey, FactPointTo*>::iterator iter = interned_facts_.find(key);
+	if (iter != interned_facts_.end()) {
+		return iter->second;
+	}
 	FactPointTo *fact = new FactPointTo(v, set);
 	facts_.push_back(fact);
+	interned_facts_[key] = fact;
 	return fact;
 }
 
 FactPointTo *
 FactPointTo::make_fact(const Variable* v, const Variable* point_to)
 {
-	FactPointTo *fact = new FactPointTo(v, point_to);
-	facts_.push_back(fact);
-	return fact;
+	vector<const Variable*> set(1, point_to);
+	return make_fact(v, set);
 }
 
 vector<const Fact*>
@@ -568,6 +577,9 @@ FactPointTo::point_to_str(const Variable* v)
 bool
 FactPointTo::equal(const Fact& f) const
 {
+    if (this == &f) {
+        return true;
+    }
     if (eCat == f.eCat) {
         const FactPointTo& fact = (const FactPointTo&)f;
         return (var == fact.get_var() && equal_variable_sets(point_to_vars, fact.get_point_to_vars()));
@@ -844,14 +856,21 @@ FactPointTo::aggregate_all_pointto_sets(void)
 		if (funcs[i]->is_builtin)
 			continue;
 		FactMgr* fm = get_fact_mgr_for_func(funcs[i]);
-		map<const Statement*, vector<Fact*> >::iterator iter;
-		for(iter = fm->map_facts_out_final.begin(); iter != fm->map_facts_out_final.end(); ++iter) {
-			update_ptr_aliases(iter->second, all_ptrs, all_aliases);
+		for (size_t j=0; j<fm->map_facts_out_final.slots(); j++) {
+			update_ptr_aliases(fm->map_facts_out_final.value(j), all_ptrs, all_aliases);
 		}
 	}
 	assert(all_ptrs.size() == all_aliases.size());
 }
 
+void
+FactPointTo::doFinalization(void)
+{
+	all_ptrs.clear();
+	all_aliases.clear();
+	interned_facts_.clear();
+}
+
 /* find union fields that are referred to by this expression */
 int
 FactPointTo::find_union_pointees(const vector<const Fact*>& facts, const Expression* e, vector<const Variable*>& unions)
@@ -34,6 +34,7 @@
 
 #include <ostream>
 #include <vector>
+#include <map>
 #include "Fact.h"
 
 class Variable;
@@ -110,8 +111,8 @@ public:
 	static const Variable* garbage_ptr;
 	static const Variable* tbd_ptr;
 
-	static vector<const Variable*> all_ptrs;
-	static vector<vector<const Variable*> > all_aliases;
+	static thread_local vector<const Variable*> all_ptrs;
+	static thread_local vector<vector<const Variable*> > all_aliases;
 private:
 	FactPointTo(const Variable* v, const vector<const Variable*>& set);
 	FactPointTo(const Variable* v, const Variable* point_to);
@@ -121,6 +122,10 @@ private:
 
 	static void update_ptr_aliases(const vector<Fact*>& facts, vector<const Variable*>& ptrs, vector<vector<const Variable*> >& aliases);
 
+	// facts created by make_fact, keyed by variable and point-to set
+	typedef std::pair<const Variable*, vector<const Variable*> > InternKey;
+	static thread_local std::map<InternKey, FactPointTo*> interned_facts_;
+
 	// unimplement
 	FactPointTo(const FactPointTo& f);
 	FactPointTo &operator=(const FactPointTo &ev);
@@ -49,6 +49,7 @@
 
 const int  FactUnion::TOP = -2;
 const int  FactUnion::BOTTOM = -1;
+thread_local std::map<FactUnion::InternKey, FactUnion*> FactUnion::interned_facts_;
 
 /*
  * constructor
@@ -164,12 +165,21 @@ FactUnion::clone(void) const
 	return fact;
 }
 
+/*
+ * facts returned by make_fact are interned and shared, don't modify them
+ */
 FactUnion *
 FactUnion::make_fact(const Variable* v, int fid)
 {
 	assert(v == NULL || v->type->eType == eUnion);
+	InternKey key(v, fid);
+	map<InternKey, FactUnion*>::iterator iter = interned_facts_.find(key);
+	if (iter != interned_facts_.end()) {
+		return iter->second;
+	}
 	FactUnion *fact = new FactUnion(v, fid);
 	facts_.push_back(fact);
+	interned_facts_[key] = fact;
 	return fact;
 }
 
@@ -184,6 +194,12 @@ FactUnion::make_facts(const vector<const Variable*>& vars, int fid)
 	return facts;
 }
 
+void
+FactUnion::doFinalization(void)
+{
+	interned_facts_.clear();
+}
+
 bool
 FactUnion::is_nonreadable_field(const Variable *v, const std::vector<const Fact*>& facts)
 {
@@ -204,6 +220,9 @@ FactUnion::is_nonreadable_field(const Variable *v, const std::vector<const Fact*
 bool
 FactUnion::equal(const Fact& f) const
 {
+	if (this == &f) {
+		return true;
+	}
     if (is_related(f)) {
         const FactUnion& fact = (const FactUnion&)f;
 		return last_written_fid == fact.get_last_written_fid();
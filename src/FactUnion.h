@@ -33,6 +33,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include <ostream>
 #include <vector>
+#include <map>
 #include "Fact.h"
 #include "Variable.h"
 
@@ -94,6 +95,10 @@ private:
 
 	// last written field id
 	int  last_written_fid;
+
+	// facts created by make_fact, keyed by union variable and field id
+	typedef std::pair<const Variable*, int> InternKey;
+	static thread_local std::map<InternKey, FactUnion*> interned_facts_;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
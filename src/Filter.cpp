@@ -67,6 +67,18 @@ void Filter::disable(FilterKind kind)
 	kinds_[kind] = false;
 }
 
+/*
+ * Collect the values in [0, n) that are not filtered out, in increasing
+ * order, and return true.  Many filters change state when they are called
+ * (e.g. mark the types they pass as used), so by default this returns false
+ * and the caller has to check the values one by one.
+ */
+bool
+Filter::get_admissible_values(unsigned int, std::vector<unsigned int> &) const
+{
+	return false;
+}
+
 /*
  *
  */
@@ -31,6 +31,7 @@
 #define FILTER_H
 
 #include <bitset>
+#include <vector>
 
 enum FilterKind {
 	fDefault,
@@ -48,6 +49,8 @@ public:
 
 	virtual bool filter(int v) const = 0;
 
+	virtual bool get_admissible_values(unsigned int n, std::vector<unsigned int> &vals) const;
+
 	void enable(FilterKind kind);
 
 	void disable(FilterKind kind);
@@ -42,6 +42,13 @@
 #include "Probabilities.h"
 #include "StatementGoto.h"
 #include "ExtensionMgr.h"
+#include "ArrayVariable.h"
+#include "FactPointTo.h"
+#include "SafeOpFlags.h"
+#include "PartialExpander.h"
+#include "Error.h"
+#include "util.h"
+#include "Arena.h"
 
 void
 Finalization::doFinalization()
@@ -55,5 +62,31 @@ Finalization::doFinalization()
 	Probabilities::DestroyInstance();
 	StatementGoto::doFinalization();
 	ExtensionMgr::DestroyExtension();
+	Arena::program_arena().reset();
+}
+
+/*
+ * Release everything that belongs to the current program, so that the next
+ * one can be generated from scratch in the same process.  Options,
+ * probabilities and extensions are kept.
+ */
+void
+Finalization::doProgramFinalization()
+{
+	Function::doFinalization();
+	VariableSelector::doFinalization();
+	Variable::doFinalization();
+	ArrayVariable::doFinalization();
+	Type::doFinalization();
+	FunctionInvocationUser::doFinalization();
+	FactPointTo::doFinalization();
+	StatementGoto::doFinalization();
+	Statement::doFinalization();
+	Bookkeeper::doFinalization();
+	SafeOpFlags::doFinalization();
+	PartialExpander::restore_init_values();
+	reset_gensym();
+	Error::set_error(SUCCESS);
+	Arena::program_arena().reset();
 }
 
@@ -33,6 +33,8 @@
 class Finalization {
 public:
 	static void doFinalization();
+
+	static void doProgramFinalization();
 private:
 	Finalization();
 	~Finalization();
@@ -72,12 +72,12 @@ using namespace std;
 
 ///////////////////////////////////////////////////////////////////////////////
 
-AttributeGenerator func_attr_generator;
-static vector<Function*> FuncList;		// List of all functions in the program
-static vector<FactMgr*>  FMList;        // list of fact managers for each function
-static long cur_func_idx;				// Index into FuncList that we are currently working on
-static bool param_first=true;			// Flag to track output of commas
-static int builtin_functions_cnt;
+static thread_local AttributeGenerator func_attr_generator;
+static thread_local vector<Function*> FuncList;		// List of all functions in the program
+static thread_local vector<FactMgr*>  FMList;        // list of fact managers for each function
+static thread_local long cur_func_idx;				// Index into FuncList that we are currently working on
+static thread_local bool param_first=true;			// Flag to track output of commas
+static thread_local int builtin_functions_cnt;
 
 static std::vector<string> common_func_attributes;
 
@@ -304,7 +304,7 @@ Function::choose_func(vector<Function *> funcs,
 	for (i = funcs.begin(); i != funcs.end(); ++i) {
 		// skip any function which has incompatible return type
 		// if type = 0, we don't care
-		if (type && !type->is_convertable((*i)->return_type))
+		if (type && !type->match((*i)->return_type, eConvert))
 			continue;
 		// Changing the behavior of is_convertable is quite dangerous.
 		// Making constraint here has less global effect.
@@ -416,6 +416,7 @@ Function::Function(const string &name, const Type *return_type)
 	  is_inlined(false),
 	  is_builtin(false),
 	  visited_cnt(0),
+	  stm_cnt(0),
 	  build_state(UNBUILT)
 {
 	FuncList.push_back(this);			// Add to global list of functions.
@@ -430,6 +431,7 @@ Function::Function(const string &name, const Type *return_type, bool builtin)
 	  is_inlined(false),
 	  is_builtin(builtin),
 	  visited_cnt(0),
+	  stm_cnt(0),
 	  build_state(UNBUILT)
 {
 	FuncList.push_back(this);			// Add to global list of functions.
@@ -962,6 +964,11 @@ Function::doFinalization(void)
 	}
 	FMList.clear();
 	FactMgr::doFinalization();
+
+	cur_func_idx = 0;
+	builtin_functions_cnt = 0;
+	param_first = true;
+	func_attr_generator.clear();
 }
 
 Function::~Function()
@@ -47,6 +47,7 @@ using namespace std;
 
 #include "Effect.h"
 #include "Type.h"
+#include "VariableIndex.h"
 
 class Block;
 class Variable;
@@ -102,6 +103,8 @@ public:
 
 	std::string name;
 	std::vector<Variable*> param;
+	// param bucketed by type, synced on use by VariableSelector
+	mutable VariableIndex param_index;
 //	vector<Expression*> param_value;
 	const Type* return_type;
 //	bool isBackLink;
@@ -121,6 +124,7 @@ public:
 	bool is_inlined;
 	bool is_builtin;
 	int  visited_cnt;
+	int  stm_cnt;	// number of statements that have a func_stm_id
 	Effect accum_eff_context;
 	void InitializeAttributes();
 
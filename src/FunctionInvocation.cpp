@@ -508,7 +508,7 @@ FunctionInvocation::visit_facts(vector<const Fact*>& inputs, CGContext& cg_conte
 	bool unordered = false; //has_uncertain_call();
 	bool ok = false;
 	bool is_func_call = (invoke_type == eFuncCall);
-	static int g = 0;
+	static thread_local int g = 0;
 	Effect running_eff_context(cg_context.get_effect_context());
 	if (!unordered) {
 		// unsigned int flags = ptr_cmp ? (cg_context.flags | NO_DANGLING_PTR) : cg_context.flags;
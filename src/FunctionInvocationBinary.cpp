@@ -47,7 +47,7 @@
 
 using namespace std;
 
-static vector<bool> needcomma;  // Flag to track output of commas
+static thread_local vector<bool> needcomma;  // Flag to track output of commas
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -69,10 +69,10 @@
 
 using namespace std;
 
-static vector<bool> needcomma;  // Flag to track output of commas
+static thread_local vector<bool> needcomma;  // Flag to track output of commas
 
-static vector<const FunctionInvocationUser*> invocations;   // list of function calls
-static vector<const Fact*> return_facts;              // list of return facts
+static thread_local vector<const FunctionInvocationUser*> invocations;   // list of function calls
+static thread_local vector<const Fact*> return_facts;              // list of return facts
 
 const Fact*
 get_return_fact_for_invocation(const FunctionInvocationUser* fiu, const Variable* var, enum eFactCategory cat)
@@ -337,11 +337,21 @@ FunctionInvocationUser::revisit(std::vector<const Fact*>& inputs, CGContext& cg_
 	// add facts related to pass parameters
 	fm->caller_to_callee_handover(this, inputs);
 
-	map<const Statement*, FactVec> facts_in_copy = fm->map_facts_in;
-	map<const Statement*, FactVec> facts_out_copy = fm->map_facts_out;
-	map<const Statement*, Effect>  stm_effect_copy = fm->map_stm_effect;
-	map<const Statement*, Effect>  accum_effect_copy = fm->map_accum_effect;
-	// TODO: revisit only if "contingent variable" has been changed?
+	if (func->body->is_summary_reusable(inputs, cg_context)) {
+		// the body was last analyzed with the same inputs, and its effect does
+		// not conflict with this context: the analysis takes the shortcut and
+		// can't fail, so no backup is needed. The facts it would merge into
+		// the final in/out maps have been merged in already
+		if (!func->body->visit_facts(inputs, cg_context))
+			assert(0);
+		finish_revisit(inputs, inputs_copy, cg_context);
+		return true;
+	}
+
+	StatementMap<FactVec> facts_in_copy = fm->map_facts_in;
+	StatementMap<FactVec> facts_out_copy = fm->map_facts_out;
+	StatementMap<Effect>  stm_effect_copy = fm->map_stm_effect;
+	StatementMap<Effect>  accum_effect_copy = fm->map_accum_effect;
 	if (!func->body->visit_facts(inputs, cg_context)) {
 		// restore facts and effect
 		fm->map_facts_in = facts_in_copy;
@@ -351,6 +361,18 @@ FunctionInvocationUser::revisit(std::vector<const Fact*>& inputs, CGContext& cg_
 		inputs = inputs_copy;
 		return false;
 	}
+	fm->setup_in_out_maps(false);
+	finish_revisit(inputs, inputs_copy, cg_context);
+	return true;
+}
+
+/*
+ * incorporate the outputs of a successful revisit into the caller's facts
+ */
+void
+FunctionInvocationUser::finish_revisit(std::vector<const Fact*>& inputs, std::vector<const Fact*>& inputs_copy, CGContext& cg_context) const
+{
+	FactMgr* fm = get_fact_mgr_for_func(func);
 	cg_context.add_effect(fm->map_stm_effect[func->body]);
 	FactVec ret_facts;
 	func->body->add_back_return_facts(fm, ret_facts);
@@ -361,13 +383,11 @@ FunctionInvocationUser::revisit(std::vector<const Fact*>& inputs, CGContext& cg_
 	// remove facts related to passing parameters
 	FactMgr::update_facts_for_oos_vars(func->param, inputs);
 
-	fm->setup_in_out_maps(false);
 	// remember the effect context during this visit to this function
 	func->accum_eff_context.add_external_effect(cg_context.get_effect_context());
 	// update the original facts with new facts changed by function call
 	renew_facts(inputs_copy, inputs);
 	inputs = inputs_copy;
-	return true;
 }
 
 /*
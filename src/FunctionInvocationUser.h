@@ -97,6 +97,7 @@ private:
 	//FunctionInvocationUser &operator=(const FunctionInvocationUser &fi);
 
 	bool build_invocation(Function *target, CGContext &cg_context);
+	void finish_revisit(std::vector<const Fact*>& inputs, std::vector<const Fact*>& inputs_copy, CGContext& cg_context) const;
 };
 
 const Fact* get_return_fact_for_invocation(const FunctionInvocationUser* fiu, const Variable* var, enum eFactCategory cat);
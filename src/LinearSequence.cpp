@@ -38,6 +38,7 @@
 #include <iostream>
 
 #include "CGOptions.h"
+#include "SequenceFile.h"
 
 using namespace std;
 
@@ -66,7 +67,10 @@ LinearSequence::init_sequence()
 void
 LinearSequence::add_number(int v, int /*bound*/, int k)
 {
-	seq_map_[k] = v;
+	assert(k >= 0);
+	if (static_cast<size_t>(k) >= seq_.size())
+		seq_.resize(k + 1, 0);
+	seq_[k] = v;
 }
 
 int
@@ -78,7 +82,10 @@ LinearSequence::get_number(int /*bound*/)
 int
 LinearSequence::get_number_by_pos(int pos)
 {
-	int rv = seq_map_[pos];
+	assert(pos >= 0);
+	if (static_cast<size_t>(pos) >= seq_.size())
+		seq_.resize(pos + 1, 0);
+	int rv = seq_[pos];
 	assert(rv >= 0);
 	return rv;
 }
@@ -86,23 +93,30 @@ LinearSequence::get_number_by_pos(int pos)
 void
 LinearSequence::clear()
 {
-	seq_map_.clear();
+	seq_.clear();
 }
 
 void
 LinearSequence::get_sequence(ostream &ss)
 {
-	assert(!seq_map_.empty());
+	assert(!seq_.empty());
 
 	size_t i = 0;
-	for (i = 0; i < seq_map_.size() - 1; ++i) {
-		ss << seq_map_[i] << sep_char_;
+	for (i = 0; i < seq_.size() - 1; ++i) {
+		ss << seq_[i] << sep_char_;
 	}
-	ss << seq_map_[i];
+	ss << seq_[i];
+}
+
+void
+LinearSequence::get_sequence(SequenceWriter &writer)
+{
+	for (size_t i = 0; i < seq_.size(); ++i)
+		writer.add(seq_[i]);
 }
 
 unsigned INT64
 LinearSequence::sequence_length()
 {
-	return seq_map_.size();
+	return seq_.size();
 }
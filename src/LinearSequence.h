@@ -30,8 +30,8 @@
 #ifndef LINEAR_SEQUENCE_H
 #define LINEAR_SEQUENCE_H
 
-#include <map>
 #include <string>
+#include <vector>
 
 #include "Sequence.h"
 
@@ -55,12 +55,15 @@ public:
 
 	virtual void get_sequence(std::ostream &);
 
+	virtual void get_sequence(SequenceWriter &writer);
+
 	virtual char get_sep_char() const { return sep_char_; }
 
 	static const char default_sep_char;
 
 private:
-	std::map<int, int> seq_map_;
+	// the number at each position
+	std::vector<int> seq_;
 
 	const char sep_char_;
 };
@@ -34,6 +34,7 @@
 #include "OutputMgr.h"
 
 #include <cassert>
+#include <cstring>
 #include <sstream>
 #include "Common.h"
 #include "CGOptions.h"
@@ -46,6 +47,11 @@
 #include "ExtensionMgr.h"
 #include "Constant.h"
 #include "ArrayVariable.h"
+#include "FactMgr.h"
+#include "Effect.h"
+#include "RuntimeInliner.h"
+#include "SafeOpFlags.h"
+#include "Statement.h"
 #include "git_version.h"
 #include "random.h"
 #include "util.h"
@@ -73,7 +79,9 @@ using namespace std;
 
 vector<string> OutputMgr::monitored_funcs_;
 
-std::string OutputMgr::curr_func_ = "";
+thread_local std::string OutputMgr::curr_func_ = "";
+
+thread_local std::map<int, std::vector<const Variable *> > OutputMgr::step_hash_writes_;
 
 void
 OutputMgr::set_curr_func(const std::string &fname)
@@ -110,7 +118,7 @@ OutputMgr::OutputMain(std::ostream &out)
 
 	FunctionInvocation *invoke = NULL;
 	invoke = ExtensionMgr::MakeFuncInvocation(GetFirstFunction(), cg_context);
-	out << endl << endl;
+	out << '\n' << '\n';
 	output_comment_line(out, "----------------------------------------");
 
 	ExtensionMgr::OutputInit(out);
@@ -127,14 +135,14 @@ OutputMgr::OutputMain(std::ostream &out)
 	}
 	else {
 		// set up a global variable that controls if we print the hash value after computing it for each global
-		out << "    int print_hash_value = 0;" << endl;
+		out << "    int print_hash_value = 0;" << '\n';
 		if (CGOptions::accept_argc()) {
-			out << "    if (argc == 2 && strcmp(argv[1], \"1\") == 0) print_hash_value = 1;" << endl;
+			out << "    if (argc == 2 && strcmp(argv[1], \"1\") == 0) print_hash_value = 1;" << '\n';
 		}
 
-		out << "    platform_main_begin();" << endl;
+		out << "    platform_main_begin();" << '\n';
 		if (CGOptions::compute_hash()) {
-			out << "    crc32_gentab();" << endl;
+			out << "    crc32_gentab();" << '\n';
 		}
 
 		ExtensionMgr::OutputFirstFunInvocation(out, invoke);
@@ -142,33 +150,39 @@ OutputMgr::OutputMain(std::ostream &out)
 	#if 0
 		out << "    ";
 		invoke->Output(out);
-		out << ";" << endl;
+		out << ";" << '\n';
 	#endif
 		// resetting all global dangling pointer to null per Rohit's request
 		if (!CGOptions::dangling_global_ptrs()) {
 			OutputPtrResets(out, GetFirstFunction()->dead_globals);
 		}
 
+		if (CGOptions::step_hash_by_effect())
+			out << "    crc32_context = 0xFFFFFFFFUL;" << '\n';
 		if (CGOptions::step_hash_by_stmt())
-			OutputMgr::OutputHashFuncInvocation(out, 1);
+			OutputMgr::OutputHashFuncInvocation(out, 1, "print_hash_value");
 		else
 			HashGlobalVariables(out);
 		if (CGOptions::compute_hash()) {
-			out << "    platform_main_end(crc32_context ^ 0xFFFFFFFFUL, print_hash_value);" << endl;
+			out << "    platform_main_end(crc32_context ^ 0xFFFFFFFFUL, print_hash_value);" << '\n';
 		} else {
-			out << "    platform_main_end(0,0);" << endl;
+			out << "    platform_main_end(0,0);" << '\n';
 		}
 	}
 	ExtensionMgr::OutputTail(out);
-	out << "}" << endl;
+	out << "}" << '\n';
 	delete invoke;
 }
 
+/*
+ * The hash function can't see the print_hash_value of main, so it is
+ * passed in
+ */
 void
-OutputMgr::OutputHashFuncInvocation(std::ostream &out, int indent)
+OutputMgr::OutputHashFuncInvocation(std::ostream &out, int indent, const char *print_hash_value)
 {
 	OutputMgr::output_tab_(out, indent);
-	out << OutputMgr::hash_func_name << "();" << std::endl;
+	out << OutputMgr::hash_func_name << "(" << print_hash_value << ");" << '\n';
 }
 
 void
@@ -176,58 +190,145 @@ OutputMgr::OutputStepHashFuncInvocation(std::ostream &out, int indent, int stmt_
 {
 	if (is_monitored_func()) {
 		OutputMgr::output_tab_(out, indent);
-		out << OutputMgr::step_hash_func_name << "(" << stmt_id << ");" << std::endl;
+		out << OutputMgr::step_hash_func_name << "(" << stmt_id << ");" << '\n';
+	}
+}
+
+/*
+ * Return the global variable that holds <v>, or NULL if <v> is local.
+ */
+static const Variable *
+get_global_holder(const Variable *v)
+{
+	const Variable *top = v->get_collective()->get_top_container();
+	while (top != v) {
+		v = top;
+		top = v->get_collective()->get_top_container();
+	}
+	return v->is_global() ? v : NULL;
+}
+
+/*
+ * Call the step hash after <stm>, and remember the global variables
+ * its effect may write, which is all the step hash needs to look at.
+ */
+void
+OutputMgr::OutputStepHashFuncInvocation(std::ostream &out, int indent, const Statement *stm)
+{
+	if (!is_monitored_func() || stm->must_jump())
+		return;
+
+	FactMgr *fm = get_fact_mgr_for_func(stm->func);
+	assert(fm);
+	const vector<const Variable *> &writes = fm->map_stm_effect[stm].get_write_vars();
+	const vector<Variable *> &globals = *VariableSelector::GetGlobalVariables();
+	vector<const Variable *> &hashed = step_hash_writes_[stm->stm_id];
+	hashed.clear();
+	for (size_t i = 0; i < globals.size(); i++) {
+		for (size_t j = 0; j < writes.size(); j++) {
+			if (get_global_holder(writes[j]) == globals[i]) {
+				hashed.push_back(globals[i]);
+				break;
+			}
+		}
 	}
+
+	OutputMgr::output_tab_(out, indent);
+	out << OutputMgr::step_hash_func_name << "(" << stm->stm_id << ");" << '\n';
+}
+
+/*
+ * The step hash for --step-hash-by-effect: add the globals written by
+ * statement <stmt_id> to the running checksum. Unlike the full step hash,
+ * it neither rehashes all globals nor rebuilds the CRC table.
+ */
+void
+OutputMgr::OutputStepHashByEffectFuncDef(std::ostream &out)
+{
+	out << '\n';
+	out << "void " << OutputMgr::step_hash_func_name << "(int stmt_id)" << '\n';
+	out << "{" << '\n';
+
+	int indent = 1;
+	// the globals are only added to the checksum here; main prints them
+	OutputMgr::output_tab_(out, indent);
+	out << "int print_hash_value = 0;" << '\n';
+	size_t dimen = Variable::GetMaxArrayDimension(*VariableSelector::GetGlobalVariables());
+	if (dimen) {
+		vector <const Variable*> &ctrl_vars = Variable::get_new_ctrl_vars();
+		OutputArrayCtrlVars(ctrl_vars, out, dimen, indent);
+	}
+	OutputMgr::output_tab_(out, indent);
+	out << "switch (stmt_id) {" << '\n';
+	std::map<int, std::vector<const Variable *> >::const_iterator i;
+	for (i = step_hash_writes_.begin(); i != step_hash_writes_.end(); ++i) {
+		if (i->second.empty())
+			continue;
+		OutputMgr::output_tab_(out, indent);
+		out << "case " << i->first << ":" << '\n';
+		for (size_t j = 0; j < i->second.size(); j++)
+			i->second[j]->hash(out);
+		OutputMgr::output_tab_(out, indent+1);
+		out << "break;" << '\n';
+	}
+	OutputMgr::output_tab_(out, indent);
+	out << "}" << '\n';
+	out << "}" << '\n';
+	step_hash_writes_.clear();
 }
 
 void
 OutputMgr::OutputStepHashFuncDef(std::ostream &out)
 {
-	out << std::endl;
-	out << "void " << OutputMgr::step_hash_func_name << "(int stmt_id)" << std::endl;
-	out << "{" << std::endl;
+	if (CGOptions::step_hash_by_effect()) {
+		OutputStepHashByEffectFuncDef(out);
+		return;
+	}
+	out << '\n';
+	out << "void " << OutputMgr::step_hash_func_name << "(int stmt_id)" << '\n';
+	out << "{" << '\n';
 
 	int indent = 1;
 	OutputMgr::output_tab_(out, indent);
-	out << "int i = 0;" << std::endl;
-	OutputMgr::OutputHashFuncInvocation(out, indent);
+	out << "int i = 0;" << '\n';
+	OutputMgr::OutputHashFuncInvocation(out, indent, "0");
 	OutputMgr::output_tab_(out, indent);
 	out << "printf(\"before stmt(%d): ";
-	out << "checksum = %X\\n\", stmt_id, crc32_context ^ 0xFFFFFFFFUL);" << std::endl;
+	out << "checksum = %X\\n\", stmt_id, crc32_context ^ 0xFFFFFFFFUL);" << '\n';
 
 	OutputMgr::output_tab_(out, indent);
-	out << "crc32_context = 0xFFFFFFFFUL; " << std::endl;
+	out << "crc32_context = 0xFFFFFFFFUL; " << '\n';
 
 	OutputMgr::output_tab_(out, indent);
-	out << "for (i = 0; i < 256; i++) { " << std::endl;
+	out << "for (i = 0; i < 256; i++) { " << '\n';
 	OutputMgr::output_tab_(out, indent+1);
-	out << "crc32_tab[i] = 0;" << std::endl;
+	out << "crc32_tab[i] = 0;" << '\n';
 	OutputMgr::output_tab_(out, indent);
-	out << "}" << std::endl;
+	out << "}" << '\n';
 	OutputMgr::output_tab_(out, indent);
-	out << "crc32_gentab();" << endl;
-	out << "}" << std::endl;
+	out << "crc32_gentab();" << '\n';
+	out << "}" << '\n';
 }
 
 void
 OutputMgr::OutputHashFuncDecl(std::ostream &out)
 {
-	out << "void " << OutputMgr::hash_func_name << "(void);";
-	out << std::endl << std::endl;
+	out << "void " << OutputMgr::hash_func_name << "(int print_hash_value);";
+	out << '\n' << '\n';
 }
 
 void
 OutputMgr::OutputStepHashFuncDecl(std::ostream &out)
 {
 	out << "void " << OutputMgr::step_hash_func_name << "(int stmt_id);";
-	out << std::endl << std::endl;
+	out << '\n' << '\n';
 }
 
 void
 OutputMgr::OutputHashFuncDef(std::ostream &out)
 {
-	out << "void " << OutputMgr::hash_func_name << "(void)" << std::endl;
-	out << "{" << std::endl;
+	out << "void " << OutputMgr::hash_func_name << "(int print_hash_value)" << '\n';
+	out << "{" << '\n';
 
 	size_t dimen = Variable::GetMaxArrayDimension(*VariableSelector::GetGlobalVariables());
 	if (dimen) {
@@ -235,17 +336,17 @@ OutputMgr::OutputHashFuncDef(std::ostream &out)
 		OutputArrayCtrlVars(ctrl_vars, out, dimen, 1);
 	}
 	HashGlobalVariables(out);
-	out << "}" << std::endl;
+	out << "}" << '\n';
 }
 
 void
 OutputMgr::OutputTail(std::ostream &out)
 {
 	if (!CGOptions::concise()) {
-		out << endl << "/************************ statistics *************************" << endl;
+		out << '\n' << "/************************ statistics *************************" << '\n';
 		Bookkeeper::output_statistics(out);
-		out << "********************* end of statistics **********************/" << endl;
-		out << endl;
+		out << "********************* end of statistics **********************/" << '\n';
+		out << '\n';
 	}
 }
 
@@ -262,14 +363,14 @@ OutputMgr::OutputHeader(int argc, char *argv[], unsigned long seed)
 				out << " " << argv[i];
 			}
 		}
-		out << endl;
+		out << '\n';
 	}
 	else {
-		out << "/*" << endl;
-		out << " * This is a RANDOMLY GENERATED PROGRAM." << endl;
-		out << " *" << endl;
-		out << " * Generator: " << PACKAGE_STRING << endl;
-		out << " * Git version: " << git_version << endl;
+		out << "/*" << '\n';
+		out << " * This is a RANDOMLY GENERATED PROGRAM." << '\n';
+		out << " *" << '\n';
+		out << " * Generator: " << PACKAGE_STRING << '\n';
+		out << " * Git version: " << git_version << '\n';
 		out << " * Options:  ";
 		if (argc <= 1) {
 			out << " (none)";
@@ -278,16 +379,29 @@ OutputMgr::OutputHeader(int argc, char *argv[], unsigned long seed)
 				out << " " << argv[i];
 			}
 		}
-		out << endl;
-		out << " * Seed:      " << seed << endl;
-		out << " */" << endl;
-		out << endl;
+		out << '\n';
+		out << " * Seed:      " << seed << '\n';
+		out << " */" << '\n';
+		out << '\n';
 	}
 
 	if (!CGOptions::longlong()) {
-		out << endl;
-		out << "#define NO_LONGLONG" << std::endl;
-		out << endl;
+		out << '\n';
+		out << "#define NO_LONGLONG" << '\n';
+		out << '\n';
+	}
+	if (CGOptions::math_builtins()) {
+		out << '\n';
+		out << "#define USE_MATH_BUILTINS" << '\n';
+		out << '\n';
+	}
+	if (CGOptions::crc_algorithm() != CGOPTIONS_DEFAULT_CRC_ALGORITHM) {
+		out << '\n';
+		if (CGOptions::crc_algorithm() == "slice8")
+			out << "#define CSMITH_CRC_SLICE8" << '\n';
+		else
+			out << "#define CSMITH_CRC32C" << '\n';
+		out << '\n';
 	}
 	if (CGOptions::enable_float()) {
 		out << "#include <float.h>\n";
@@ -296,33 +410,33 @@ OutputMgr::OutputHeader(int argc, char *argv[], unsigned long seed)
 
 	ExtensionMgr::OutputHeader(out);
 
-	out << runtime_include << endl;
+	out << runtime_include << '\n';
 
  	if (!CGOptions::compute_hash()) {
 		if (CGOptions::allow_int64())
-			out << "volatile uint64_t " << Variable::sink_var_name << " = 0;" << endl;
+			out << "volatile uint64_t " << Variable::sink_var_name << " = 0;" << '\n';
 		else
-			out << "volatile uint32_t " << Variable::sink_var_name << " = 0;" << endl;
+			out << "volatile uint32_t " << Variable::sink_var_name << " = 0;" << '\n';
 	}
-	out << endl;
+	out << '\n';
 
-	out << "static long __undefined;" << endl;
-	out << endl;
+	out << "static long __undefined;" << '\n';
+	out << '\n';
 
 	if (CGOptions::depth_protect()) {
-		out << "#define MAX_DEPTH (5)" << endl;
+		out << "#define MAX_DEPTH (5)" << '\n';
 		// Make depth signed, to cover our tails.
-		out << "int32_t DEPTH = 0;" << endl;
-		out << endl;
+		out << "int32_t DEPTH = 0;" << '\n';
+		out << '\n';
 	}
 
-	// out << platform_include << endl;
+	// out << platform_include << '\n';
 	if (CGOptions::wrap_volatiles()) {
-		out << volatile_include << endl;
+		out << volatile_include << '\n';
 	}
 
 	if (CGOptions::access_once()) {
-		out << access_once_macro << endl;
+		out << access_once_macro << '\n';
 	}
 
 	if (CGOptions::step_hash_by_stmt()) {
@@ -384,7 +498,22 @@ OutputMgr::output_tab(ostream &out, int indent)
 void
 OutputMgr::really_outputln(ostream &out)
 {
-	out << std::endl;
+	out << '\n';
+}
+
+/*
+ * For --self-contained: replace the include of csmith.h in the text of a
+ * whole program by the runtime headers, keeping only the safe math wrappers
+ * the program calls.  The wrappers are known only once the program has been
+ * output, so this cannot be done by OutputHeader.
+ */
+void
+OutputMgr::InlineRuntime(std::string &text)
+{
+	size_t pos = text.find(runtime_include);
+	assert(pos != string::npos);
+	text.replace(pos, strlen(runtime_include),
+				 RuntimeInliner::expand("csmith.h", SafeOpFlags::wrapper_names));
 }
 
 //////////////////////////////////////////////////////////////////
@@ -30,11 +30,13 @@
 #ifndef OUTPUT_MGR_H
 #define OUTPUT_MGR_H
 
+#include <map>
 #include <ostream>
 #include <vector>
 #include <string>
 using namespace std;
 
+class Statement;
 class Variable;
 
 #define TAB "    "    // to beautify output: 1 tab is 4 spaces
@@ -49,16 +51,20 @@ public:
 
 	static void OutputHashFuncDecl(std::ostream &out);
 
-	static void OutputHashFuncInvocation(std::ostream &out, int indent);
+	static void OutputHashFuncInvocation(std::ostream &out, int indent, const char *print_hash_value);
 
 	static void OutputStepHashFuncInvocation(std::ostream &out, int indent, int stmt_id);
 
+	static void OutputStepHashFuncInvocation(std::ostream &out, int indent, const Statement *stm);
+
 	static void OutputStepHashFuncDecl(std::ostream &out);
 
 	static void OutputStepHashFuncDef(std::ostream &out);
 
 	static void really_outputln(std::ostream &out);
 
+	static void InlineRuntime(std::string &text);
+
 	static void set_curr_func(const std::string &fname);
 
 	virtual void OutputHeader(int argc, char *argv[], unsigned long seed) = 0;
@@ -67,7 +73,7 @@ public:
 
 	virtual void Output() = 0;
 
-	virtual void outputln(ostream &out) {out << std::endl;}
+	virtual void outputln(ostream &out) {out << '\n';}
 
 	virtual void output_comment_line(ostream &out, const std::string &comment);
 
@@ -94,7 +100,13 @@ private:
 
 	static bool is_monitored_func(void);
 
-	static std::string curr_func_;
+	static void OutputStepHashByEffectFuncDef(std::ostream &out);
+
+	static thread_local std::string curr_func_;
+
+	// The global variables to hash after each statement, by statement id,
+	// for --step-hash-by-effect.
+	static thread_local std::map<int, std::vector<const Variable *> > step_hash_writes_;
 
 };
 
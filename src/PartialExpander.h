@@ -59,7 +59,7 @@ private:
 
 	static bool parse_options(const std::string &options, char sep_char);
 
-	static std::map<eStatementType, bool> expands_;
+	static thread_local std::map<eStatementType, bool> expands_;
 
 	static std::map<eStatementType, bool> expands_backup_;
 };
@@ -92,6 +92,33 @@ ProbabilityFilter::filter(int v) const
 	return rv;
 }
 
+bool
+ProbabilityFilter::get_admissible_values(unsigned int n, std::vector<unsigned int> &vals) const
+{
+	Probabilities *prob = Probabilities::GetInstance();
+	assert(prob);
+	// an extra filter may change state when called, so let the caller
+	// check the values one by one
+	if (prob->extra_filters_[pname_] != NULL)
+		return false;
+
+	GroupProbElem *elem = dynamic_cast<GroupProbElem*>(prob->probabilities_[pname_]);
+	assert(elem);
+	assert(elem->is_equal());
+
+	set<unsigned int> disabled;
+	map<ProbName, SingleProbElem *>::iterator i;
+	for (i = elem->probs_.begin(); i != elem->probs_.end(); ++i) {
+		if ((*i).second->get_prob_direct() == 0)
+			disabled.insert(Probabilities::pname_to_type((*i).first));
+	}
+	for (unsigned int v = 0; v < n; v++) {
+		if (disabled.find(v) == disabled.end())
+			vals.push_back(v);
+	}
+	return true;
+}
+
 /////////////////////////////////////////////////////////////////
 ProbElem::~ProbElem()
 {
@@ -900,9 +927,9 @@ bool
 Probabilities::check_extra_filter(ProbName pname, int v)
 {
 	assert(v >= 0);
-	std::map<ProbName, Filter*>::iterator i = extra_filters_.find(pname);
-	if (i != extra_filters_.end() && ((*i).second != NULL))
-		return (*i).second->filter(v);
+	Filter *filter = extra_filters_[pname];
+	if (filter != NULL)
+		return filter->filter(v);
 	else
 		return false;
 }
@@ -1094,9 +1121,10 @@ Probabilities::dump_default_probabilities(const string &fname)
 	assert(!fname.empty());
 	ofstream out(fname.c_str());
 
-	std::map<ProbName, ProbElem*>::iterator i; 
-	for (i = probabilities_.begin(); i != probabilities_.end(); ++i) {
-		(*i).second->dump_default(out);
+	for (int i = 0; i < pProbNameCount; ++i) {
+		if (probabilities_[i] == NULL)
+			continue;
+		probabilities_[i]->dump_default(out);
 		out << std::endl << std::endl;
 	}
 }
@@ -1108,9 +1136,10 @@ Probabilities::dump_actual_probabilities(const string &fname, unsigned long seed
 	ofstream out(fname.c_str());
 	out << "# Seed: " << seed << std::endl << std::endl;
 
-	std::map<ProbName, ProbElem*>::iterator i;
-	for (i = probabilities_.begin(); i != probabilities_.end(); ++i) {
-		(*i).second->dump_val(out);
+	for (int i = 0; i < pProbNameCount; ++i) {
+		if (probabilities_[i] == NULL)
+			continue;
+		probabilities_[i]->dump_val(out);
 		out << std::endl << std::endl;
 	}
 }
@@ -1118,30 +1147,32 @@ Probabilities::dump_actual_probabilities(const string &fname, unsigned long seed
 //////////////////////////////////////////////////////////////////////
 Probabilities::Probabilities()
 {
-
+	for (int i = 0; i < pProbNameCount; ++i) {
+		probabilities_[i] = NULL;
+		prob_filters_[i] = NULL;
+		extra_filters_[i] = NULL;
+	}
 }
 
 void
-Probabilities::clear_filter(std::map<ProbName, Filter*> &filters)
+Probabilities::clear_filter(Filter **filters)
 {
-	std::map<ProbName, Filter*>::iterator j;
-	for (j = filters.begin(); j!= filters.end(); ++j) {
-		Filter *f = (*j).second;
+	for (int i = 0; i < pProbNameCount; ++i) {
+		Filter *f = filters[i];
 		if (f)
 			delete f;
+		filters[i] = NULL;
 	}
-	filters.clear();
 }
 
 Probabilities::~Probabilities()
 {
-	std::map<ProbName, ProbElem*>::iterator i;
-	for (i = probabilities_.begin(); i != probabilities_.end(); ++i) {
-		ProbElem *elem = (*i).second;
-		assert(elem);
-		delete elem;
+	for (int i = 0; i < pProbNameCount; ++i) {
+		ProbElem *elem = probabilities_[i];
+		if (elem)
+			delete elem;
+		probabilities_[i] = NULL;
 	}
-	probabilities_.clear();
 	clear_filter(prob_filters_);
 	clear_filter(extra_filters_);
 }
@@ -1151,6 +1182,7 @@ void DistributionTable::add_entry(int key, int prob)
 	keys_.push_back(key);
 	probs_.push_back(prob);
 	max_prob_ += prob;
+	bounds_.push_back(max_prob_);
 }
 
 int DistributionTable::key_to_prob(int key) const
@@ -1167,14 +1199,28 @@ int DistributionTable::key_to_prob(int key) const
 int DistributionTable::rnd_num_to_key(int rnd) const
 {
 	assert(rnd < max_prob_ && rnd >= 0);
+	assert(keys_.size() == bounds_.size());
+	vector<int>::const_iterator i = upper_bound(bounds_.begin(), bounds_.end(), rnd);
+	assert(i != bounds_.end());
+	return keys_[i - bounds_.begin()];
+}
+
+/*
+ * Collect the random numbers in [0, n) that map to a key in <keys>, or to a
+ * key not in <keys> if <in_keys> is false.
+ */
+void DistributionTable::get_rnd_nums(const vector<unsigned int> &keys, bool in_keys, unsigned int n, vector<unsigned int> &rnds) const
+{
 	assert(keys_.size() == probs_.size());
-	for (size_t i=0; i<probs_.size(); i++) {
-		if (rnd < probs_[i]) {
-			return keys_[i];
+	unsigned int lo = 0;
+	for (size_t i=0; i<probs_.size() && lo<n; i++) {
+		unsigned int hi = lo + probs_[i];
+		bool found = find(keys.begin(), keys.end(), static_cast<unsigned int>(keys_[i])) != keys.end();
+		if (found == in_keys) {
+			for (unsigned int r=lo; r<hi && r<n; r++)
+				rnds.push_back(r);
 		}
-		rnd -= probs_[i];
+		lo = hi;
 	}
-	assert(0);
-	return -1;
 }
 
@@ -157,6 +157,8 @@ enum ProbName {
 	pVarAttrProb,
 	pBinaryConstProb,
 
+	// number of probability names, not a probability
+	pProbNameCount
 };
 
 #define MAX_PROB_NAME ((ProbName)(pStatementProb+1))
@@ -275,6 +277,8 @@ public:
 	virtual ~ProbabilityFilter(void);
 
 	virtual bool filter(int v) const;
+
+	virtual bool get_admissible_values(unsigned int n, std::vector<unsigned int> &vals) const;
 private:
 	const ProbName pname_;
 };
@@ -448,7 +452,7 @@ private:
 
 	void initialize_single_probs();
 
-	void clear_filter(std::map<ProbName, Filter*> &filter);
+	void clear_filter(Filter **filters);
 
 	void initialize_group_probs();
 
@@ -474,11 +478,12 @@ private:
 
 	std::map<ProbName, unsigned int> pname_to_type_;
 
-	std::map<ProbName, ProbElem *> probabilities_;
+	// indexed by ProbName; NULL for names without an element or filter
+	ProbElem *probabilities_[pProbNameCount];
 
-	std::map<ProbName, Filter*> prob_filters_;
+	Filter *prob_filters_[pProbNameCount];
 
-	std::map<ProbName, Filter*> extra_filters_;
+	Filter *extra_filters_[pProbNameCount];
 	//const static ProbabilityFilter *binary_ops_prob_filter_;
 
 	Probabilities();
@@ -46,15 +46,20 @@ class TableEntry {
 public:
 	TableEntry(Key k, Value v);
 
-	Key get_key() { return key_; }
+	Key get_key() const { return key_; }
 
-	Value get_value() { return value_; }
+	Value get_value() const { return value_; }
 
 private:
 	Key key_;
 	Value value_;
 };
 
+/*
+ * Maps a random number to a value.  Each entry's key is the upper bound
+ * (exclusive) of the numbers mapped to its value, so entries are kept
+ * sorted by key, by value in one vector, and looked up by binary search.
+ */
 template <class Key, class Value>
 class ProbabilityTable {
 	typedef TableEntry<Key, Value> Entry;
@@ -68,13 +73,13 @@ public:
 
 	void add_elem(Key k, Value v);
 
-	void sorted_insert(Entry *t);
-
-	Value get_value(Key k);
+	Value get_value(Key k) const;
 
 private:
+	static bool key_less(Key k, const Entry &e) { return k < e.get_key(); }
+
 	Key curr_max_key_;
-	std::vector<Entry *> table_;
+	std::vector<Entry> table_;
 };
 
 template <class Key, class Value>
@@ -94,9 +99,6 @@ ProbabilityTable<Key, Value>::ProbabilityTable()
 template <class Key, class Value>
 ProbabilityTable<Key, Value>::~ProbabilityTable()
 {
-	typename vector<Entry *>::iterator i;
-	for (i = table_.begin(); i != table_.end(); ++i)
-		delete (*i);
 	table_.clear();
 }
 
@@ -107,70 +109,30 @@ void ProbabilityTable<Key, Value>::initialize(ProbName pname)
 	impl_->set_prob_table(this, pname);
 }
 
-template <class Key, class Value>
-bool my_less(TableEntry<Key, Value> *t, Key k2)
-{
-	Key k1 = t->get_key();
-	return (k1 < k2);
-}
-
-template <class Key, class Value>
-bool my_greater(TableEntry<Key, Value> *t, Key k2)
-{
-	Key k1 = t->get_key();
-	return (k1 > k2);
-}
-
-template <class Key, class Value>
-void
-ProbabilityTable<Key, Value>::sorted_insert(Entry *t)
-{
-	assert(t);
-
-	Key k = t->get_key();
-
-	if (table_.empty()) {
-		table_.push_back(t);
-		curr_max_key_ = k;
-		return;
-	}
-
-	typename vector<Entry *>::iterator i;
-	for (i=table_.begin(); i!=table_.end(); i++) {
-		if (my_greater<Key, Value>(*i, k)) {
-			break;
-		}
-	}
-	//i = find_if(table_.begin(), table_.end(), std::bind2nd(std::ptr_fun(my_greater<Key, Value>), k));
-
-	if (i != table_.end()) {
-		table_.insert(i, t);
-	}
-	else {
-		table_.push_back(t);
-		curr_max_key_ = k;
-	}
-}
-
+/*
+ * Insert after the entries whose keys are less or equal to k, so that of
+ * entries with equal keys the first added wins.
+ */
 template <class Key, class Value>
 void
 ProbabilityTable<Key, Value>::add_elem(Key k, Value v)
 {
-	Entry *t = new Entry(k, v);
-	sorted_insert(t);
+	typename vector<Entry>::iterator i = upper_bound(table_.begin(), table_.end(), k, key_less);
+	if (i == table_.end())
+		curr_max_key_ = k;
+	table_.insert(i, Entry(k, v));
 }
 
 template <class Key, class Value>
 Value
-ProbabilityTable<Key, Value>::get_value(Key k)
+ProbabilityTable<Key, Value>::get_value(Key k) const
 {
 	assert(k < curr_max_key_);
 
-	typename vector<Entry *>::iterator i;
-	i = find_if(table_.begin(), table_.end(), std::bind2nd(std::ptr_fun(my_greater<Key, Value>), k));
+	typename vector<Entry>::const_iterator i = upper_bound(table_.begin(), table_.end(), k, key_less);
 
 	assert(i != table_.end());
-	return (*i)->get_value();
+	return i->get_value();
 }
 
 class DistributionTable {
@@ -182,10 +144,13 @@ public:
 	int get_max(void) const { return max_prob_;}
 	int key_to_prob(int key) const;
 	int rnd_num_to_key(int rnd) const;
+	void get_rnd_nums(const vector<unsigned int> &keys, bool in_keys, unsigned int n, vector<unsigned int> &rnds) const;
 private:
 	int max_prob_;
 	vector<int> keys_;
 	vector<int> probs_;
+	// running totals of probs_, for binary search in rnd_num_to_key
+	vector<int> bounds_;
 };
 
 #endif
@@ -0,0 +1,299 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#if HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "ProgramArchive.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+
+static const char archive_magic[] = "CSMITHAR";
+
+static const uint32_t archive_version = 1;
+
+static const size_t header_size = 32;
+
+static const size_t entry_size = 40;
+
+ProgramArchive *ProgramArchive::instance_ = NULL;
+
+static void
+put_u32(char *p, uint32_t v)
+{
+	for (int i = 0; i < 4; ++i)
+		p[i] = static_cast<char>((v >> (8 * i)) & 0xff);
+}
+
+static void
+put_u64(char *p, uint64_t v)
+{
+	for (int i = 0; i < 8; ++i)
+		p[i] = static_cast<char>((v >> (8 * i)) & 0xff);
+}
+
+static uint32_t
+get_u32(const char *p)
+{
+	uint32_t v = 0;
+	for (int i = 3; i >= 0; --i)
+		v = (v << 8) | static_cast<unsigned char>(p[i]);
+	return v;
+}
+
+static uint64_t
+get_u64(const char *p)
+{
+	uint64_t v = 0;
+	for (int i = 7; i >= 0; --i)
+		v = (v << 8) | static_cast<unsigned char>(p[i]);
+	return v;
+}
+
+static void
+make_header(char *header, uint64_t index_offset, uint64_t count)
+{
+	memcpy(header, archive_magic, 8);
+	put_u32(header + 8, archive_version);
+	put_u32(header + 12, entry_size);
+	put_u64(header + 16, index_offset);
+	put_u64(header + 24, count);
+}
+
+/*
+ * Create the archive <fname>, or return NULL if it can't be created.
+ */
+ProgramArchive *
+ProgramArchive::CreateInstance(const std::string &fname, int argc, char *argv[])
+{
+	assert(!instance_);
+	ProgramArchive *archive = new ProgramArchive(fname, argc, argv);
+	if (!archive->out_) {
+		delete archive;
+		return NULL;
+	}
+	instance_ = archive;
+	return instance_;
+}
+
+ProgramArchive *
+ProgramArchive::GetInstance()
+{
+	assert(instance_);
+	return instance_;
+}
+
+void
+ProgramArchive::DestroyInstance()
+{
+	if (instance_ && !instance_->close())
+		cerr << "error: can't write archive " << instance_->fname_ << std::endl;
+	delete instance_;
+	instance_ = NULL;
+}
+
+uint64_t
+ProgramArchive::hash(const char *s, std::size_t n, uint64_t h)
+{
+	for (size_t i = 0; i < n; ++i) {
+		h ^= static_cast<unsigned char>(s[i]);
+		h *= 1099511628211ULL;
+	}
+	return h;
+}
+
+uint64_t
+ProgramArchive::options_hash(int argc, char *argv[])
+{
+	// options that don't change the programs, and whether they take a value
+	static const struct { const char *name; bool has_value; } skipped[] = {
+		{ "--seed", true }, { "-s", true }, { "--count", true },
+		{ "--seed-range", true }, { "--output-dir", true }, { "--jobs", true },
+		{ "--fork-server", false }, { "--archive", true }, { "--extract", true },
+		{ "--dedup", true },
+		{ "--output", true }, { "-o", true },
+	};
+	uint64_t h = FNV_OFFSET_BASIS;
+	for (int i = 1; i < argc; ++i) {
+		bool skip = false;
+		for (size_t j = 0; j < sizeof(skipped) / sizeof(skipped[0]); ++j) {
+			if (strcmp(argv[i], skipped[j].name) == 0) {
+				skip = true;
+				if (skipped[j].has_value)
+					++i;
+				break;
+			}
+		}
+		if (!skip)
+			h = hash(argv[i], strlen(argv[i]) + 1, h);
+	}
+	return h;
+}
+
+ProgramArchive::ProgramArchive(const std::string &fname, int argc, char *argv[])
+	: fname_(fname),
+	  out_(fname.c_str(), ios_base::out | ios_base::binary | ios_base::trunc),
+	  options_hash_(options_hash(argc, argv)),
+	  offset_(header_size)
+{
+	char header[header_size];
+	make_header(header, 0, 0);
+	out_.write(header, header_size);
+}
+
+ProgramArchive::~ProgramArchive()
+{
+}
+
+/*
+ * Append the program generated with <seed>.  Return false if the archive
+ * can't be written, now or earlier.
+ */
+bool
+ProgramArchive::append(unsigned long seed, const std::string &text)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	out_.write(text.data(), text.size());
+	if (!out_)
+		return false;
+	Entry e;
+	e.seed = seed;
+	e.offset = offset_;
+	e.length = text.size();
+	e.options_hash = options_hash_;
+	e.checksum = hash(text.data(), text.size());
+	index_.push_back(e);
+	offset_ += text.size();
+	return true;
+}
+
+/*
+ * Write the index sorted by seed, and fill in the header.  The header is
+ * only filled in once everything before it is written, and the header
+ * itself last; return false if any write failed.
+ */
+bool
+ProgramArchive::close()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	stable_sort(index_.begin(), index_.end(), entry_less);
+
+	std::vector<char> buf(index_.size() * entry_size);
+	for (size_t i = 0; i < index_.size(); ++i) {
+		char *p = &buf[i * entry_size];
+		put_u64(p, index_[i].seed);
+		put_u64(p + 8, index_[i].offset);
+		put_u64(p + 16, index_[i].length);
+		put_u64(p + 24, index_[i].options_hash);
+		put_u64(p + 32, index_[i].checksum);
+	}
+	if (!buf.empty())
+		out_.write(&buf[0], buf.size());
+	out_.flush();
+	if (!out_) {
+		out_.close();
+		return false;
+	}
+
+	char header[header_size];
+	make_header(header, offset_, index_.size());
+	out_.seekp(0);
+	out_.write(header, header_size);
+	out_.close();
+	return !out_.fail();
+}
+
+/*
+ * Write the program generated with <seed> from the archive <fname> to
+ * <out>.  On failure, return false with the reason in <err>.
+ */
+bool
+ProgramArchive::extract(const std::string &fname, unsigned long seed, std::ostream &out, std::string &err)
+{
+	ifstream in(fname.c_str(), ios_base::in | ios_base::binary);
+	if (!in) {
+		err = "can't open archive " + fname;
+		return false;
+	}
+
+	char header[header_size];
+	if (!in.read(header, header_size) || memcmp(header, archive_magic, 8) != 0
+			|| get_u32(header + 8) != archive_version || get_u32(header + 12) != entry_size) {
+		err = fname + " is not a csmith archive";
+		return false;
+	}
+	uint64_t index_offset = get_u64(header + 16);
+	uint64_t count = get_u64(header + 24);
+	if (index_offset == 0) {
+		err = "archive " + fname + " is incomplete";
+		return false;
+	}
+
+	// binary search in the index, reading one entry at a time
+	char entry[entry_size];
+	uint64_t lo = 0, hi = count;
+	while (lo < hi) {
+		uint64_t mid = lo + (hi - lo) / 2;
+		in.seekg(index_offset + mid * entry_size);
+		if (!in.read(entry, entry_size)) {
+			err = "archive " + fname + " is truncated";
+			return false;
+		}
+		uint64_t s = get_u64(entry);
+		if (s < seed) {
+			lo = mid + 1;
+		}
+		else if (s > seed) {
+			hi = mid;
+		}
+		else {
+			uint64_t offset = get_u64(entry + 8);
+			uint64_t length = get_u64(entry + 16);
+			std::string text(length, '\0');
+			in.seekg(offset);
+			if (length > 0 && !in.read(&text[0], length)) {
+				err = "archive " + fname + " is truncated";
+				return false;
+			}
+			if (hash(text.data(), text.size()) != get_u64(entry + 32)) {
+				err = "checksum mismatch in archive " + fname;
+				return false;
+			}
+			out << text;
+			return true;
+		}
+	}
+	err = "no program for the seed in archive " + fname;
+	return false;
+}
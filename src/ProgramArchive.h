@@ -0,0 +1,112 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#ifndef PROGRAM_ARCHIVE_H
+#define PROGRAM_ARCHIVE_H
+
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+/*
+ * A single file holding the programs of a batch, written with --archive.
+ * All integers are little-endian.
+ *
+ *   header (32 bytes):  "CSMITHAR", u32 version, u32 index entry size,
+ *                       u64 index offset, u64 number of programs
+ *   program texts:      one after another, from offset 32
+ *   index:              one entry per program, sorted by seed:
+ *                       u64 seed, u64 offset, u64 length,
+ *                       u64 options hash, u64 checksum of the text
+ *
+ * The index is written, and the header filled in, when the archive is
+ * closed; an archive whose index offset is 0 was not completed.  A write
+ * that fails leaves the archive that way, so a full disk can't produce a
+ * truncated archive with an index that looks valid.  Both
+ * hashes are 64-bit FNV-1a.  The options hash covers the command line
+ * minus the options that only say which seeds to generate and where to
+ * write them, so programs generated with the same options have the same
+ * options hash.
+ *
+ * Programs may be appended from several threads.
+ */
+class ProgramArchive
+{
+public:
+	static ProgramArchive *CreateInstance(const std::string &fname, int argc, char *argv[]);
+
+	static ProgramArchive *GetInstance();
+
+	static void DestroyInstance();
+
+	bool append(unsigned long seed, const std::string &text);
+
+	static bool extract(const std::string &fname, unsigned long seed, std::ostream &out, std::string &err);
+
+	static uint64_t hash(const char *s, std::size_t n, uint64_t h = FNV_OFFSET_BASIS);
+
+private:
+	struct Entry {
+		uint64_t seed;
+		uint64_t offset;
+		uint64_t length;
+		uint64_t options_hash;
+		uint64_t checksum;
+	};
+
+	ProgramArchive(const std::string &fname, int argc, char *argv[]);
+
+	~ProgramArchive();
+
+	bool close();
+
+	static bool entry_less(const Entry &e1, const Entry &e2) { return e1.seed < e2.seed; }
+
+	static uint64_t options_hash(int argc, char *argv[]);
+
+	static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+
+	static ProgramArchive *instance_;
+
+	std::string fname_;
+
+	std::ofstream out_;
+
+	uint64_t options_hash_;
+
+	uint64_t offset_;
+
+	std::vector<Entry> index_;
+
+	std::mutex mutex_;
+};
+
+#endif // PROGRAM_ARCHIVE_H
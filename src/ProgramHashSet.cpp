@@ -0,0 +1,121 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#if HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "ProgramHashSet.h"
+
+#include <cassert>
+#include <iostream>
+
+using namespace std;
+
+ProgramHashSet *ProgramHashSet::instance_ = NULL;
+
+/*
+ * Load the hash set <fname>, creating it if needed, or return NULL if it
+ * can't be read or written.
+ */
+ProgramHashSet *
+ProgramHashSet::CreateInstance(const std::string &fname)
+{
+	assert(!instance_);
+	ProgramHashSet *set = new ProgramHashSet();
+	if (!set->load(fname)) {
+		delete set;
+		return NULL;
+	}
+	instance_ = set;
+	return instance_;
+}
+
+ProgramHashSet *
+ProgramHashSet::GetInstance()
+{
+	return instance_;
+}
+
+void
+ProgramHashSet::DestroyInstance()
+{
+	delete instance_;
+	instance_ = NULL;
+}
+
+ProgramHashSet::ProgramHashSet()
+{
+}
+
+ProgramHashSet::~ProgramHashSet()
+{
+	if (out_.is_open())
+		out_.close();
+}
+
+bool
+ProgramHashSet::load(const std::string &fname)
+{
+	ifstream in(fname.c_str(), ios_base::in | ios_base::binary);
+	char buf[8];
+	while (in.read(buf, sizeof(buf))) {
+		uint64_t h = 0;
+		for (int i = 7; i >= 0; --i)
+			h = (h << 8) | static_cast<unsigned char>(buf[i]);
+		hashes_.insert(h);
+	}
+	// the hashes appended to a truncated file would be misaligned
+	if (in.gcount() != 0)
+		return false;
+
+	out_.open(fname.c_str(), ios_base::out | ios_base::binary | ios_base::app);
+	return out_.is_open();
+}
+
+/*
+ * Add <h> to the set.  Return false if it was already there.
+ */
+bool
+ProgramHashSet::insert(uint64_t h)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (!hashes_.insert(h).second)
+		return false;
+
+	char buf[8];
+	for (int i = 0; i < 8; ++i)
+		buf[i] = static_cast<char>((h >> (8 * i)) & 0xff);
+	// flush before the program is written, so that a crash or a kill
+	// can't lose the hash
+	out_.write(buf, sizeof(buf));
+	out_.flush();
+	if (!out_)
+		cerr << "error: can't write to hash set" << std::endl;
+	return true;
+}
@@ -0,0 +1,73 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#ifndef PROGRAM_HASH_SET_H
+#define PROGRAM_HASH_SET_H
+
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <stdint.h>
+
+/*
+ * The hashes of the programs generated so far, for --dedup.  The set is
+ * kept in a file of little-endian 64-bit hashes: it is loaded when created,
+ * and every new hash is appended and flushed to it, so duplicates are also
+ * found across runs sharing the file, even runs that were killed.
+ *
+ * Hashes may be inserted from several threads.
+ */
+class ProgramHashSet
+{
+public:
+	static ProgramHashSet *CreateInstance(const std::string &fname);
+
+	static ProgramHashSet *GetInstance();
+
+	static void DestroyInstance();
+
+	bool insert(uint64_t h);
+
+private:
+	ProgramHashSet();
+
+	~ProgramHashSet();
+
+	bool load(const std::string &fname);
+
+	static ProgramHashSet *instance_;
+
+	std::unordered_set<uint64_t> hashes_;
+
+	std::ofstream out_;
+
+	std::mutex mutex_;
+};
+
+#endif // PROGRAM_HASH_SET_H
@@ -38,7 +38,7 @@
 #include "AbsRndNumGenerator.h"
 #include "Filter.h"
 
-RandomNumber *RandomNumber::instance_ = NULL;
+thread_local RandomNumber *RandomNumber::instance_ = NULL;
 
 RandomNumber::RandomNumber(const unsigned long seed)
 	: seed_(seed)
@@ -141,6 +141,12 @@ RandomNumber::get_sequence(std::string &sequence)
 	curr_generator_->get_sequence(sequence);
 }
 
+void
+RandomNumber::get_sequence(SequenceWriter &writer)
+{
+	curr_generator_->get_sequence(writer);
+}
+
 unsigned int
 RandomNumber::rnd_upto(const unsigned int n, const Filter *f, const std::string *where)
 {
@@ -177,5 +183,6 @@ RandomNumber::doFinalization()
 		delete generator;
 	}
 	delete instance_;
+	instance_ = NULL;
 }
 
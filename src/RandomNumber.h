@@ -38,6 +38,7 @@
 #include "AbsRndNumGenerator.h"
 
 class Filter;
+class SequenceWriter;
 
 /*
  * Common interface of all random number generators.
@@ -64,6 +65,8 @@ public:
 
 	void get_sequence(std::string &sequence);
 
+	void get_sequence(SequenceWriter &writer);
+
 	// Probably it's not a good idea to define those functions with default arguments.
 	// It would have potential problem to be misused.
 	// I defined them in this way only for compatible to the previous code.
@@ -83,7 +86,7 @@ protected:
 
 	AbsRndNumGenerator *curr_generator_;
 
-	static RandomNumber *instance_;
+	static thread_local RandomNumber *instance_;
 
 	std::map<RNDNUM_GENERATOR, AbsRndNumGenerator*> generators_;
 
@@ -92,6 +92,7 @@ FUTURE:
 
 #include "CGOptions.h"
 #include "AbsProgramGenerator.h"
+#include "ProgramArchive.h"
 
 #include "git_version.h"
 #include "platform.h"
@@ -156,6 +157,24 @@ static void print_help()
 		 << endl;
 	cout << "  --output <filename> or -o <filename>: specify the output file name." << endl
 		 << endl;
+	cout << "  --count <num>: generate <num> programs in one run, using consecutive seeds starting from the given (or random) seed (default 1)." << endl
+		 << endl;
+	cout << "  --seed-range <first>-<last>: generate one program for each seed in [<first>, <last>] in one run." << endl
+		 << endl;
+	cout << "  --output-dir <dir>: with --count or --seed-range, write each program to <dir>/<seed>.c instead of concatenating them." << endl
+		 << endl;
+	cout << "  --jobs <num>: with --count or --seed-range, generate the programs in <num> parallel threads (requires --output-dir or --archive)." << endl
+		 << endl;
+	cout << "  --archive <file>: write the generated programs to the single archive <file>, indexed by seed, instead of to stdout." << endl
+		 << endl;
+	cout << "  --extract <seed>: with --archive, print the program generated with <seed> from the archive (or write it to the --output file) instead of generating programs." << endl
+		 << endl;
+	cout << "  --dedup <file>: with --count or --seed-range, skip the programs whose text, apart from the header, is the same as that of a program generated before. The hashes of the programs are kept in <file>, so duplicates are also found across runs. The seeds of skipped programs are reported on stderr." << endl
+		 << endl;
+	cout << "  --rng <rand48|xoshiro256>: the random number engine (default rand48). With xoshiro256, each seed selects its own non-overlapping stream of the generator, so programs of a batch never share random numbers." << endl
+		 << endl;
+	cout << "  --fork-server: after initialization, read seeds from stdin, one per line, and generate each program in a forked process as <dir>/<seed>.c (requires --output-dir). \"<seed> ok\" or \"<seed> failed\" is written to stdout for each seed." << endl
+		 << endl;
 
 	// enabling/disabling options
 	cout << "  --argc | --no-argc: generate main function with/without argv and argc being passed (enabled by default)." << endl
@@ -166,6 +185,9 @@ static void print_help()
 		 << endl;
 	cout << "  --checksum | --no-checksum: enable | disable checksum calculation (enabled by default)." << endl
 		 << endl;
+	cout << "  --crc <crc32|slice8|crc32c>: compute the checksum with byte-wise CRC-32 (default), CRC-32 through ";
+	cout << "slice-by-8 tables (same checksums), or CRC-32C, using the SSE4.2 crc32 instruction where available." << endl
+		 << endl;
 	cout << "  --comma-operators | --no-comma-operators: enable | disable comma operators (enabled by default)." << endl
 		 << endl;
 	cout << "  --compound-assignment | --no-compound-assignment: enable | disable compound assignments (enabled by default)." << endl
@@ -302,6 +324,10 @@ static void print_advanced_help()
 	// dfs-exhaustive mode options
 	cout << "  --dfs-exhaustive: enable depth first exhaustive random generation (disabled by default)." << endl
 		 << endl;
+	cout << "  --dfs-checkpoint: keep a forked snapshot of the generator at each decision point, ";
+	cout << "so that backtracking resumes from the deepest shared prefix instead of regenerating the whole program. ";
+	cout << "Only works in the exhaustive mode." << endl
+		 << endl;
 	cout << "  --expand-struct: enable the expansion of struct in the exhaustive mode. ";
 	cout << "Only works in the exhaustive mode and cannot used with --no-structs." << endl
 		 << endl;
@@ -372,9 +398,9 @@ static void print_advanced_help()
 	// delta related options
 	cout << "  --delta-monitor [simple]: specify the type of delta monitor. Only [simple] type is supported now." << endl
 		 << endl;
-	cout << "  --delta-input [file]: specify the file for delta input." << endl
+	cout << "  --delta-input [file]: generate the program from the random choices in [file], as written by --delta-output, instead of from the seed." << endl
 		 << endl;
-	cout << "  --delta-output [file]: specify the file for delta output (default to <delta-input>)." << endl
+	cout << "  --delta-output [file]: write the random choices made for the program to [file], in a compact binary format." << endl
 		 << endl;
 	cout << "  --go-delta [simple]: run delta reduction on <delta-input>." << endl
 		 << endl;
@@ -409,6 +435,12 @@ static void print_advanced_help()
 	// other options
 	cout << "  --math-notmp: make csmith generate code for safe_math_macros_notmp." << endl
 		 << endl;
+	cout << "  --math-builtins: make csmith generate code for safe_math_builtins, which checks for overflow ";
+	cout << "with the __builtin_*_overflow functions of GCC and Clang." << endl
+		 << endl;
+	cout << "  --self-contained: copy the runtime headers into the program instead of including csmith.h, ";
+	cout << "keeping only the safe math wrappers the program uses, so that it compiles without -I." << endl
+		 << endl;
 
 	cout << "  --strict-const-arrays: restrict array elements to constants." << endl
 		 << endl;
@@ -430,6 +462,10 @@ static void print_advanced_help()
 	cout << "  --step-hash-by-stmt: dump the checksum after each statement. It is applied to all functions unless --monitor-funcs is specified." << endl
 		 << endl;
 
+	cout << "  --step-hash-by-effect: like --step-hash-by-stmt, but after each statement only hash the global variables ";
+	cout << "the statement may write, into a running checksum." << endl
+		 << endl;
+
 	cout << "  --stop-by-stmt <num>: try to stop generating statements after the statement with id <num>." << endl
 		 << endl;
 
@@ -469,10 +505,16 @@ static void print_advanced_help()
 		 << endl;
 	cout << "  --no-hash-value-printf: do not emit printf on the index of an array" << endl
 		 << endl;
+
+	cout << "  --bulk-array-hash: hash each non-volatile integer array with one runtime call ";
+	cout << "instead of a loop over its elements. The checksum stays the same." << endl
+		 << endl;
 	cout << "  --no-signed-char-index: do not allow a var of type char to be used as array index" << endl
 		 << endl;
 	cout << "  --strict-float: do not allow assignments between floats and integers" << endl
 		 << endl;
+	cout << "  --rejection-sampling: redraw filtered random choices until one passes, as older versions did, so that a seed generates the same program as before filter-aware sampling." << endl
+		 << endl;
 
 	// type size options
 	cout << "  --int-size <size>: specify integer size of target (default taken from platform.info if it exists otherwise from host)" << endl
@@ -490,6 +532,26 @@ void arg_check(int argc, int i)
 	}
 }
 
+// Print the program generated with <seed> from the --archive file.
+static int
+extract_from_archive(unsigned long seed)
+{
+	std::string err;
+	bool ok;
+	if (CGOptions::output_file().empty()) {
+		ok = ProgramArchive::extract(CGOptions::archive_file(), seed, cout, err);
+	}
+	else {
+		ofstream ofile(CGOptions::output_file().c_str());
+		ok = ProgramArchive::extract(CGOptions::archive_file(), seed, ofile, err);
+	}
+	if (!ok) {
+		cout << "error: " << err << std::endl;
+		return -1;
+	}
+	return 0;
+}
+
 // ----------------------------------------------------------------------------
 int main(int argc, char **argv)
 {
@@ -531,6 +593,115 @@ int main(int argc, char **argv)
 			continue;
 		}
 
+		if (strcmp(argv[i], "--count") == 0)
+		{
+			unsigned long count;
+			i++;
+			arg_check(argc, i);
+			if (!parse_int_arg(argv[i], &count))
+				exit(-1);
+			CGOptions::batch_count(count);
+			continue;
+		}
+
+		if (strcmp(argv[i], "--seed-range") == 0)
+		{
+			unsigned long first, last;
+			i++;
+			arg_check(argc, i);
+			if (sscanf(argv[i], "%lu-%lu", &first, &last) != 2 || first > last)
+			{
+				cout << "please specify seed range in the form of <first>-<last>" << std::endl;
+				exit(-1);
+			}
+			g_Seed = first;
+			CGOptions::batch_count(last - first + 1);
+			continue;
+		}
+
+		if (strcmp(argv[i], "--output-dir") == 0)
+		{
+			string dir;
+			i++;
+			arg_check(argc, i);
+			if (!parse_string_arg(argv[i], dir))
+			{
+				cout << "please specify <dir>" << std::endl;
+				exit(-1);
+			}
+			CGOptions::batch_output_dir(dir);
+			continue;
+		}
+
+		if (strcmp(argv[i], "--jobs") == 0)
+		{
+			unsigned long jobs;
+			i++;
+			arg_check(argc, i);
+			if (!parse_int_arg(argv[i], &jobs))
+				exit(-1);
+			CGOptions::batch_jobs(jobs);
+			continue;
+		}
+
+		if (strcmp(argv[i], "--fork-server") == 0)
+		{
+			CGOptions::fork_server(true);
+			continue;
+		}
+
+		if (strcmp(argv[i], "--rejection-sampling") == 0)
+		{
+			CGOptions::rejection_sampling(true);
+			continue;
+		}
+
+		if (strcmp(argv[i], "--archive") == 0)
+		{
+			string fname;
+			i++;
+			arg_check(argc, i);
+			if (!parse_string_arg(argv[i], fname))
+			{
+				cout << "please specify <file>" << std::endl;
+				exit(-1);
+			}
+			CGOptions::archive_file(fname);
+			continue;
+		}
+
+		if (strcmp(argv[i], "--dedup") == 0)
+		{
+			string fname;
+			i++;
+			arg_check(argc, i);
+			if (!parse_string_arg(argv[i], fname))
+			{
+				cout << "please specify <file>" << std::endl;
+				exit(-1);
+			}
+			CGOptions::dedup_file(fname);
+			continue;
+		}
+
+		if (strcmp(argv[i], "--extract") == 0)
+		{
+			i++;
+			arg_check(argc, i);
+			if (!parse_int_arg(argv[i], &g_Seed))
+				exit(-1);
+			CGOptions::archive_extract(true);
+			continue;
+		}
+
+		if (strcmp(argv[i], "--rng") == 0)
+		{
+			i++;
+			arg_check(argc, i);
+			CGOptions::rng(argv[i]);
+			continue;
+		}
+
 		if (strcmp(argv[i], "--temp-file") == 0)
 		{
 			i++;
@@ -855,6 +1026,12 @@ int main(int argc, char **argv)
 			continue;
 		}
 
+		if (strcmp(argv[i], "--dfs-checkpoint") == 0)
+		{
+			CGOptions::dfs_checkpoint(true);
+			continue;
+		}
+
 		if (strcmp(argv[i], "--max-pointer-depth") == 0)
 		{
 			unsigned long ret;
@@ -932,6 +1109,18 @@ int main(int argc, char **argv)
 			continue;
 		}
 
+		if (strcmp(argv[i], "--math-builtins") == 0)
+		{
+			CGOptions::math_builtins(true);
+			continue;
+		}
+
+		if (strcmp(argv[i], "--self-contained") == 0)
+		{
+			CGOptions::self_contained(true);
+			continue;
+		}
+
 		if (strcmp(argv[i], "--math64") == 0)
 		{
 			CGOptions::math64(true);
@@ -1362,6 +1551,20 @@ int main(int argc, char **argv)
 			continue;
 		}
 
+		if (strcmp(argv[i], "--crc") == 0)
+		{
+			string algorithm;
+			i++;
+			arg_check(argc, i);
+			if (!parse_string_arg(argv[i], algorithm))
+			{
+				cout << "please specify the crc algorithm!" << std::endl;
+				exit(-1);
+			}
+			CGOptions::crc_algorithm(algorithm);
+			continue;
+		}
+
 		if (strcmp(argv[i], "--builtins") == 0)
 		{
 			CGOptions::builtins(true);
@@ -1392,6 +1595,13 @@ int main(int argc, char **argv)
 			continue;
 		}
 
+		if (strcmp(argv[i], "--step-hash-by-effect") == 0)
+		{
+			CGOptions::step_hash_by_stmt(true);
+			CGOptions::step_hash_by_effect(true);
+			continue;
+		}
+
 		if (strcmp(argv[i], "--stop-by-stmt") == 0)
 		{
 			unsigned long num;
@@ -1809,6 +2019,12 @@ int main(int argc, char **argv)
 			continue;
 		}
 
+		if (strcmp(argv[i], "--bulk-array-hash") == 0)
+		{
+			CGOptions::bulk_array_hash(true);
+			continue;
+		}
+
 		if (strcmp(argv[i], "--no-signed-char-index") == 0)
 		{
 			CGOptions::signed_char_index(false);
@@ -1892,6 +2108,9 @@ int main(int argc, char **argv)
 		exit(-1);
 	}
 
+	if (CGOptions::archive_extract())
+		return extract_from_archive(g_Seed);
+
 	AbsProgramGenerator *generator = AbsProgramGenerator::CreateInstance(argc, argv, g_Seed);
 	if (!generator)
 	{
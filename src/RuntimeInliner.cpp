@@ -0,0 +1,209 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#if HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "RuntimeInliner.h"
+
+#include <cassert>
+#include <cstring>
+#include <sstream>
+
+using namespace std;
+
+static bool
+starts_with(const string &s, const char *prefix)
+{
+	return s.compare(0, strlen(prefix), prefix) == 0;
+}
+
+static bool
+is_blank(const string &s)
+{
+	return s.find_first_not_of(" \t") == string::npos;
+}
+
+/*
+ * Return the text of runtime header `name' with the runtime headers it
+ * includes expanded in place.  `wrappers' are the names of the safe math
+ * wrappers used by the program.
+ */
+string
+RuntimeInliner::expand(const string &name, const vector<string> &wrappers)
+{
+	set<string> used(wrappers.begin(), wrappers.end());
+	string out;
+	expand_header(out, name, used);
+	return out;
+}
+
+const char *
+RuntimeInliner::find_header(const string &name)
+{
+	for (const RuntimeHeader *h = runtime_headers; h->name; ++h) {
+		if (name == h->name)
+			return h->text;
+	}
+	return NULL;
+}
+
+bool
+RuntimeInliner::is_safe_math_header(const string &name)
+{
+	return starts_with(name, "safe_math");
+}
+
+/* the name in `#include "name"', or "" if the line is not such an include */
+string
+RuntimeInliner::included_header(const string &line)
+{
+	size_t i = line.find_first_not_of(" \t");
+	if (i == string::npos || line[i] != '#')
+		return "";
+	i = line.find_first_not_of(" \t", i + 1);
+	if (i == string::npos || line.compare(i, 7, "include") != 0)
+		return "";
+	size_t b = line.find('"', i + 7);
+	if (b == string::npos)
+		return "";
+	size_t e = line.find('"', b + 1);
+	if (e == string::npos)
+		return "";
+	return line.substr(b + 1, e - b - 1);
+}
+
+/*
+ * A header may be expanded at several places, e.g., custom_limits.h from
+ * each of the stdint_*.h; its include guard keeps all but the first from
+ * taking effect.
+ */
+void
+RuntimeInliner::expand_header(string &out, const string &name, const set<string> &wrappers)
+{
+	const char *text = find_header(name);
+	assert(text);
+	if (is_safe_math_header(name)) {
+		expand_safe_math(out, text, wrappers);
+		return;
+	}
+	istringstream in(text);
+	string line;
+	while (getline(in, line)) {
+		string inc = included_header(line);
+		if (!inc.empty() && find_header(inc))
+			expand_header(out, inc, wrappers);
+		else
+			out += line + '\n';
+	}
+}
+
+/*
+ * Split a safe math header into wrapper definitions and the text between
+ * them, and keep the definitions that are used.  Functions are written as
+ *
+ *   STATIC <type>
+ *   FUNC_NAME(<name>)(<parameters>)
+ *   {
+ *   ...
+ *   }
+ *
+ * and macros as `#define safe_<name>(<parameters>)' with continued lines.
+ */
+void
+RuntimeInliner::expand_safe_math(string &out, const char *text, const set<string> &wrappers)
+{
+	vector<Chunk> chunks(1);
+	istringstream in(text);
+	string line;
+	while (getline(in, line)) {
+		size_t paren = line.find('(');
+		if (starts_with(line, "STATIC ")) {
+			Chunk c;
+			c.text = line + '\n';
+			while (getline(in, line)) {
+				c.text += line + '\n';
+				if (c.name.empty() && starts_with(line, "FUNC_NAME("))
+					c.name = "safe_" + line.substr(10, line.find(')') - 10);
+				if (line == "}")
+					break;
+			}
+			chunks.push_back(c);
+			chunks.push_back(Chunk());
+		}
+		else if (starts_with(line, "#define ") && line.find("safe_") < paren) {
+			Chunk c;
+			c.name = line.substr(8, paren - 8);
+			c.text = line + '\n';
+			while (line.find_last_not_of(" \t") != string::npos
+				   && line[line.find_last_not_of(" \t")] == '\\'
+				   && getline(in, line))
+				c.text += line + '\n';
+			chunks.push_back(c);
+			chunks.push_back(Chunk());
+		}
+		else {
+			chunks.back().text += line + '\n';
+		}
+	}
+
+	// Also keep whatever the kept wrappers refer to.
+	set<string> keep(wrappers);
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		for (size_t i = 0; i < chunks.size(); i++) {
+			if (chunks[i].name.empty() || !keep.count(chunks[i].name))
+				continue;
+			for (size_t j = 0; j < chunks.size(); j++) {
+				const string &name = chunks[j].name;
+				if (!name.empty() && !keep.count(name)
+					&& chunks[i].text.find(name) != string::npos) {
+					keep.insert(name);
+					changed = true;
+				}
+			}
+		}
+	}
+
+	// The dropped definitions leave runs of blank lines; squeeze them.
+	bool blank = false;
+	for (size_t i = 0; i < chunks.size(); i++) {
+		if (!chunks[i].name.empty() && !keep.count(chunks[i].name))
+			continue;
+		istringstream lines(chunks[i].text);
+		while (getline(lines, line)) {
+			bool b = is_blank(line);
+			if (!(b && blank))
+				out += line + '\n';
+			blank = b;
+		}
+	}
+}
@@ -0,0 +1,79 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef RUNTIME_INLINER_H
+#define RUNTIME_INLINER_H
+
+#include <set>
+#include <string>
+#include <vector>
+
+/*
+ * The text of one runtime header, as built into csmith from the files in
+ * runtime/ (see cmake/EmbedRuntimeHeaders.cmake).  The table ends with an
+ * entry whose name is NULL.
+ */
+struct RuntimeHeader {
+	const char *name;
+	const char *text;
+};
+
+extern const RuntimeHeader runtime_headers[];
+
+/*
+ * Expands a runtime header for --self-contained: every `#include "..."' of
+ * another runtime header is replaced by that header's text, and the safe
+ * math headers are cut down to the wrappers the program calls, plus the
+ * helper macros those wrappers use.  Other includes are left alone.
+ */
+class RuntimeInliner
+{
+public:
+	static std::string expand(const std::string &name, const std::vector<std::string> &wrappers);
+
+private:
+	// a wrapper definition in a safe math header, or the text between two
+	// of them (with an empty name)
+	struct Chunk {
+		std::string name;
+		std::string text;
+	};
+
+	static const char *find_header(const std::string &name);
+
+	static bool is_safe_math_header(const std::string &name);
+
+	static void expand_header(std::string &out, const std::string &name, const std::set<std::string> &wrappers);
+
+	static void expand_safe_math(std::string &out, const char *text, const std::set<std::string> &wrappers);
+
+	static std::string included_header(const std::string &line);
+};
+
+#endif // RUNTIME_INLINER_H
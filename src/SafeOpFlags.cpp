@@ -45,7 +45,7 @@
 
 using namespace std;
 
-vector<string> SafeOpFlags::wrapper_names;
+thread_local vector<string> SafeOpFlags::wrapper_names;
 
 SafeOpFlags::SafeOpFlags()
 {
@@ -261,8 +261,11 @@ SafeOpFlags::OutputSize(std::ostream &out) const
 void
 SafeOpFlags::OutputFuncOrMacro(std::ostream &out) const
 {
-	is_func_ ? (out << "func_")
-		: (out << "macro_");
+	if (CGOptions::math_builtins())
+		out << "builtin_";
+	else
+		is_func_ ? (out << "func_")
+			: (out << "macro_");
 }
 
 void
@@ -349,6 +352,12 @@ SafeOpFlags::to_string(enum eUnaryOps op) const
 	return s;
 }
 
+void
+SafeOpFlags::doFinalization()
+{
+	wrapper_names.clear();
+}
+
 /* assign id to safe math function */
 int
 SafeOpFlags::to_id(std::string fname)
@@ -85,9 +85,11 @@ public:
 	std::string to_string(enum eUnaryOps  op) const;
 	static int to_id(std::string fname);
 
+	static void doFinalization();
+
 	~SafeOpFlags();
 
-	static std::vector<std::string> wrapper_names;
+	static thread_local std::vector<std::string> wrapper_names;
 private:
 	bool op1_;
 	bool op2_;
@@ -35,6 +35,8 @@
 #include <ostream>
 #include "Common.h"
 
+class SequenceWriter;
+
 class Sequence {
 public:
 	Sequence();
@@ -57,6 +59,8 @@ public:
 
 	virtual void get_sequence(std::ostream &out) = 0;
 
+	virtual void get_sequence(SequenceWriter &writer) = 0;
+
 	virtual char get_sep_char() const = 0;
 };
 
@@ -38,9 +38,9 @@
 #include <string>
 #include "LinearSequence.h"
 
-std::set<Sequence*> SequenceFactory::seqs_;
+thread_local std::set<Sequence*> SequenceFactory::seqs_;
 
-char SequenceFactory::current_sep_char_ = '_';
+thread_local char SequenceFactory::current_sep_char_ = '_';
 
 Sequence*
 SequenceFactory::make_sequence()
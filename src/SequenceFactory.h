@@ -43,9 +43,9 @@ public:
 	static char current_sep_char() { return current_sep_char_; }
 
 private:
-	static std::set<Sequence*> seqs_;
+	static thread_local std::set<Sequence*> seqs_;
 
-	static char current_sep_char_;
+	static thread_local char current_sep_char_;
 };
 
 #endif // SEQUENCE_FACTORY_H
@@ -0,0 +1,234 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#if HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "SequenceFile.h"
+
+#include <cassert>
+#include <cstring>
+
+using namespace std;
+
+const char SequenceFile::magic[4] = { 'C', 'S', 'S', 'Q' };
+
+const unsigned char SequenceFile::version = 1;
+
+static void
+put_varint(std::string &buf, unsigned int v)
+{
+	while (v >= 0x80) {
+		buf += static_cast<char>((v & 0x7f) | 0x80);
+		v >>= 7;
+	}
+	buf += static_cast<char>(v);
+}
+
+static bool
+get_varint(const std::string &buf, size_t &pos, unsigned int &v)
+{
+	v = 0;
+	for (int shift = 0; shift < 35 && pos < buf.size(); shift += 7) {
+		unsigned char c = static_cast<unsigned char>(buf[pos++]);
+		v |= static_cast<unsigned int>(c & 0x7f) << shift;
+		if (!(c & 0x80))
+			return true;
+	}
+	return false;
+}
+
+static bool
+read_varint(std::istream &in, unsigned int &v)
+{
+	v = 0;
+	for (int shift = 0; shift < 35; shift += 7) {
+		int c = in.get();
+		if (c == EOF)
+			return false;
+		v |= static_cast<unsigned int>(c & 0x7f) << shift;
+		if (!(c & 0x80))
+			return true;
+	}
+	return false;
+}
+
+//////////////////////////////////////////////////////////////////////
+SequenceWriter::SequenceWriter(std::ostream &out, bool compress)
+	: out_(out),
+	  compress_(compress),
+	  finished_(false)
+{
+	out_.write(SequenceFile::magic, sizeof(SequenceFile::magic));
+	out_.put(static_cast<char>(SequenceFile::version));
+	block_.reserve(SequenceFile::BLOCK_SIZE);
+}
+
+SequenceWriter::~SequenceWriter()
+{
+	finish();
+}
+
+void
+SequenceWriter::add(unsigned int v)
+{
+	assert(!finished_);
+	block_.push_back(v);
+	if (block_.size() == SequenceFile::BLOCK_SIZE)
+		write_block();
+}
+
+void
+SequenceWriter::write_block()
+{
+	if (block_.empty())
+		return;
+
+	raw_.clear();
+	for (size_t i = 0; i < block_.size(); ++i)
+		put_varint(raw_, block_[i]);
+
+	const std::string *payload = &raw_;
+	int kind = SequenceFile::RAW;
+	if (compress_) {
+		runs_.clear();
+		for (size_t i = 0; i < block_.size(); ) {
+			size_t j = i + 1;
+			while (j < block_.size() && block_[j] == block_[i])
+				++j;
+			put_varint(runs_, block_[i]);
+			put_varint(runs_, static_cast<unsigned int>(j - i));
+			i = j;
+		}
+		if (runs_.size() < raw_.size()) {
+			payload = &runs_;
+			kind = SequenceFile::RUNS;
+		}
+	}
+
+	std::string head;
+	head += static_cast<char>(kind);
+	put_varint(head, static_cast<unsigned int>(block_.size()));
+	put_varint(head, static_cast<unsigned int>(payload->size()));
+	out_.write(head.data(), head.size());
+	out_.write(payload->data(), payload->size());
+	block_.clear();
+}
+
+/*
+ * Write what is left and the end marker.  Return false if writing failed.
+ */
+bool
+SequenceWriter::finish()
+{
+	if (!finished_) {
+		write_block();
+		out_.put(static_cast<char>(SequenceFile::END));
+		out_.flush();
+		finished_ = true;
+	}
+	return !out_.fail();
+}
+
+//////////////////////////////////////////////////////////////////////
+SequenceReader::SequenceReader(std::istream &in)
+	: in_(in),
+	  good_(false),
+	  done_(false),
+	  kind_(SequenceFile::END),
+	  left_(0),
+	  pos_(0),
+	  run_value_(0),
+	  run_left_(0)
+{
+	char header[sizeof(SequenceFile::magic) + 1];
+	if (in_.read(header, sizeof(header))
+			&& memcmp(header, SequenceFile::magic, sizeof(SequenceFile::magic)) == 0
+			&& static_cast<unsigned char>(header[sizeof(SequenceFile::magic)]) == SequenceFile::version)
+		good_ = true;
+}
+
+bool
+SequenceReader::read_block()
+{
+	int kind = in_.get();
+	if (kind == SequenceFile::END) {
+		done_ = true;
+		return false;
+	}
+	unsigned int count, size;
+	if ((kind != SequenceFile::RAW && kind != SequenceFile::RUNS)
+			|| !read_varint(in_, count) || !read_varint(in_, size) || count == 0) {
+		good_ = false;
+		return false;
+	}
+	payload_.resize(size);
+	if (size > 0 && !in_.read(&payload_[0], size)) {
+		good_ = false;
+		return false;
+	}
+	kind_ = kind;
+	left_ = count;
+	pos_ = 0;
+	run_left_ = 0;
+	return true;
+}
+
+/*
+ * Get the next number in <v>.  Return false at the end of the sequence, or
+ * if the input is corrupt, which good() tells apart.
+ */
+bool
+SequenceReader::next(unsigned int &v)
+{
+	if (!good_ || done_)
+		return false;
+	if (left_ == 0 && !read_block())
+		return false;
+
+	if (kind_ == SequenceFile::RAW) {
+		if (!get_varint(payload_, pos_, v)) {
+			good_ = false;
+			return false;
+		}
+	}
+	else {
+		if (run_left_ == 0) {
+			if (!get_varint(payload_, pos_, run_value_) || !get_varint(payload_, pos_, run_left_)
+					|| run_left_ == 0 || run_left_ > left_) {
+				good_ = false;
+				return false;
+			}
+		}
+		v = run_value_;
+		--run_left_;
+	}
+	--left_;
+	return true;
+}
@@ -0,0 +1,129 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#ifndef SEQUENCE_FILE_H
+#define SEQUENCE_FILE_H
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*
+ * The binary format of a sequence of random choices, used by
+ * --delta-output and --delta-input:
+ *
+ *   "CSSQ", a version byte, then blocks of up to BLOCK_SIZE numbers:
+ *   a kind byte, the count of numbers and the size of the payload in
+ *   bytes, both as varints, then the payload.  The payload of a RAW block
+ *   is the numbers as varints, that of a RUNS block is (number, repeat
+ *   count) pairs of varints.  A block of kind END ends the sequence.
+ *
+ * Varints are little-endian base 128: 7 bits per byte, the high bit set on
+ * all bytes but the last.  Most choices are small, so most take one byte.
+ */
+class SequenceFile
+{
+public:
+	enum BlockKind { END = 0, RAW, RUNS };
+
+	static const std::size_t BLOCK_SIZE = 4096;
+
+	static const char magic[4];
+
+	static const unsigned char version;
+};
+
+/*
+ * Write a sequence, one number at a time, encoding it block by block.  With
+ * <compress>, a block is written as runs when that is smaller.
+ */
+class SequenceWriter
+{
+public:
+	explicit SequenceWriter(std::ostream &out, bool compress = true);
+
+	~SequenceWriter();
+
+	void add(unsigned int v);
+
+	bool finish();
+
+private:
+	void write_block();
+
+	std::ostream &out_;
+
+	bool compress_;
+
+	bool finished_;
+
+	std::vector<unsigned int> block_;
+
+	std::string raw_;
+
+	std::string runs_;
+};
+
+/*
+ * Read a sequence written by SequenceWriter, decoding one block at a time.
+ */
+class SequenceReader
+{
+public:
+	explicit SequenceReader(std::istream &in);
+
+	// false if the input is not a sequence, or is corrupt
+	bool good() const { return good_; }
+
+	bool next(unsigned int &v);
+
+private:
+	bool read_block();
+
+	std::istream &in_;
+
+	bool good_;
+
+	bool done_;
+
+	int kind_;
+
+	// numbers left in the current block
+	unsigned int left_;
+
+	std::string payload_;
+
+	std::size_t pos_;
+
+	unsigned int run_value_;
+
+	unsigned int run_left_;
+};
+
+#endif // SEQUENCE_FILE_H
@@ -87,9 +87,9 @@
 #include "Attribute.h"
 
 using namespace std;
-const Statement* Statement::failed_stm;
+thread_local const Statement* Statement::failed_stm;
 
-AttributeGenerator Statement::label_attr_generator;
+thread_local AttributeGenerator Statement::label_attr_generator;
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -111,7 +111,7 @@ public:
 
 	virtual bool filter(int v) const;
 
-	static bool label_attr_generate;
+	static thread_local bool label_attr_generate;
 private:
 	const CGContext &cg_context_;
 };
@@ -130,7 +130,7 @@ StatementFilter::~StatementFilter(void)
 
 }
 
-bool StatementFilter::label_attr_generate = false;
+thread_local bool StatementFilter::label_attr_generate = false;
 
 // use a table to define probabilities of different kinds of statements
 // Must initialize it before use
@@ -248,7 +248,20 @@ StatementProbability(const StatementFilter *filter)
 	return Statement::number_to_type(value);
 }
 
-int Statement::sid = 0;
+thread_local int Statement::sid = 0;
+
+/*
+ * Restart statement numbering for a new program
+ */
+void
+Statement::doFinalization(void)
+{
+	Statement::sid = 0;
+	Statement::failed_stm = NULL;
+	Statement::label_attr_generator.clear();
+	StatementFilter::label_attr_generate = false;
+}
+
 /*
  *
  */
@@ -389,7 +402,8 @@ Statement::is_ptr_used(void) const
 Statement::Statement(eStatementType st, Block* b)
 	: eType(st),
 	func(b ? b->func : 0),
-	parent(b)
+	parent(b),
+	func_stm_id(-1)
 {
 	stm_id = Statement::sid;
 	Statement::sid++;
@@ -403,6 +417,21 @@ Statement::~Statement(void)
 	// Nothing to do.
 }
 
+/*
+ * number the statements of a function from 0, for FactMgr's StatementMaps.
+ * The id is handed out on first use, because the body of a function only
+ * learns its function after it has been constructed
+ */
+int
+Statement::get_func_stm_id(void) const
+{
+	if (func_stm_id < 0) {
+		assert(func);
+		func_stm_id = func->stm_cnt++;
+	}
+	return func_stm_id;
+}
+
 /*
  * return true if statement is contained in block b
  */
@@ -606,6 +635,19 @@ Statement::shortcut_analysis(vector<const Fact*>& inputs, CGContext& cg_context)
 	return 2;
 }
 
+/*
+ * return true if shortcut_analysis would succeed for these inputs, i.e. the
+ * facts and effect recorded by the last analysis of this statement can be
+ * reused as they are
+ */
+bool
+Statement::is_summary_reusable(const vector<const Fact*>& inputs, const CGContext& cg_context) const
+{
+	FactMgr* fm = get_fact_mgr_for_func(func);
+	return same_facts(inputs, fm->map_facts_in[this]) && !is_ctrl_stmt() && !contains_unfixed_goto()
+		&& !cg_context.in_conflict(fm->map_stm_effect[this]);
+}
+
 /***************************************************************************************
  * for a given input env, abstract a given statement, generate an output env, and
  * update both input/output env for this statement
@@ -984,13 +1026,16 @@ Statement::post_output(std::ostream &out, FactMgr* fm, int indent) const
 	if (fm && CGOptions::paranoid() && !CGOptions::concise() && eType != eBlock) {
 		fm->output_assertions(out, this, indent, true);
 	}
+	if (CGOptions::step_hash_by_effect()) {
+		OutputMgr::OutputStepHashFuncInvocation(out, indent, this);
+	}
 }
 
 void
 Statement::output_hash(std::ostream &out, int indent) const
 {
 	// compute checksum and print out the value
-	if (CGOptions::step_hash_by_stmt()) {
+	if (CGOptions::step_hash_by_stmt() && !CGOptions::step_hash_by_effect()) {
 		OutputMgr::OutputStepHashFuncInvocation(out, indent, stm_id);
 	}
 }
@@ -44,6 +44,7 @@
 #include <sstream>
 #include <string>
 #include "Probabilities.h"
+#include "Arena.h"
 using namespace std;
 
 #ifndef STATEMENT_H
@@ -92,6 +93,8 @@ enum eStatementType
 class Statement
 {
 public:
+	ALLOCATE_FROM_PROGRAM_ARENA
+
 	// Factory method.
 	static Statement *make_random(CGContext &cg_context,
 								  eStatementType t = MAX_STATEMENT_TYPE);
@@ -122,6 +125,7 @@ public:
 	bool validate_and_update_facts(vector<const Fact*>& inputs, CGContext& cg_context) const;
 
 	int shortcut_analysis(vector<const Fact*>& inputs, CGContext& cg_context) const;
+	bool is_summary_reusable(const vector<const Fact*>& inputs, const CGContext& cg_context) const;
 
 	bool analyze_with_edges_in(vector<const Fact*>& inputs, CGContext& cg_context) const;
 
@@ -186,26 +190,33 @@ public:
 
 	static int get_current_sid(void) { return sid; }
 
+	static void doFinalization(void);
+
+	static void InitProbabilityTable();
+
 	int get_blk_depth(void) const;
 
-	static AttributeGenerator label_attr_generator;
+	int get_func_stm_id(void) const;
+
+	static thread_local AttributeGenerator label_attr_generator;
 
 	// unique id for each statement
 	int stm_id;
 	Function* func;
 	Block* parent;
-	static const Statement* failed_stm;
+	static thread_local const Statement* failed_stm;
 
 	static ProbabilityTable<unsigned int, ProbName> *stmtTable_;
 protected:
 	Statement(eStatementType st, Block* parent);
 
 private:
-	static int sid;
+	static thread_local int sid;
 
-	Statement &operator=(const Statement &s); // unimplementable
+	// dense id among the statements of func, see get_func_stm_id
+	mutable int func_stm_id;
 
-	static void InitProbabilityTable();
+	Statement &operator=(const Statement &s); // unimplementable
 };
 
 int find_stm_in_set(const vector<const Statement*>& set, const Statement* s);
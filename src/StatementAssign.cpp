@@ -188,8 +188,8 @@ StatementAssign::make_random(CGContext &cg_context, const Type* type, const CVQu
 	lhs_cg_context.get_effect_stm() = rhs_cg_context.get_effect_stm();
 	lhs_cg_context.curr_rhs = e;
 
-	bool prev_flag = CGOptions::match_exact_qualifiers(); // keep a copy of previous flag
-	if (qf) CGOptions::match_exact_qualifiers(true);      // force exact qualifier match when selecting vars
+	bool prev_flag = CGOptions::force_exact_qualifiers(); // keep a copy of previous flag
+	if (qf) CGOptions::force_exact_qualifiers(true);      // force exact qualifier match when selecting vars
 	if (CGOptions::strict_float()) {
 		lhs = Lhs::make_random(lhs_cg_context, &e->get_type(), &qfer, op != eSimpleAssign, need_no_rhs(op));
 	}
@@ -197,7 +197,7 @@ StatementAssign::make_random(CGContext &cg_context, const Type* type, const CVQu
 		lhs = Lhs::make_random(lhs_cg_context, type, &qfer, op != eSimpleAssign, need_no_rhs(op));
 	}
 
-	if (qf) CGOptions::match_exact_qualifiers(prev_flag); // restore flag
+	if (qf) CGOptions::force_exact_qualifiers(prev_flag); // restore flag
 	ERROR_GUARD_AND_DEL2(NULL, e, lhs);
 
 	// typecast, if needed.
@@ -54,7 +54,7 @@
 
 using namespace std;
 
-std::map<const Statement*, string> StatementGoto::stm_labels;
+thread_local std::map<const Statement*, string> StatementGoto::stm_labels;
 
 ///////////////////////////////////////////////////////////////////////////////
 /*
@@ -163,7 +163,7 @@ StatementGoto::make_random(CGContext &cg_context)
 			if (FactMgr::merge_jump_facts(stm_in, goto_out)) {
 				stm_out = stm_in;
 				found_new_facts = true;
-				map<const Statement*, FactVec> facts_in_copy, facts_out_copy;
+				StatementMap<FactVec> facts_in_copy, facts_out_copy;
 				fm->backup_stm_fact_maps(stm, facts_in_copy, facts_out_copy);
 				ok = stm->stm_visit_facts(stm_out, cg_context);
 				if (!ok) {
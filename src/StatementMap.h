@@ -0,0 +1,82 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef STATEMENT_MAP_H
+#define STATEMENT_MAP_H
+
+#include <cassert>
+#include <cstddef>
+#include <deque>
+#include <vector>
+#include "Statement.h"
+
+/*
+ * A map from the statements of one function to T, kept in a vector indexed
+ * by Statement::get_func_stm_id().  It replaces std::map<const Statement*, T>
+ * in FactMgr, where each visit to a statement used to do several tree
+ * lookups.  Iteration goes over the slots in statement id order; slots that
+ * were never used have a NULL statement.  The values live in a deque so that,
+ * as with std::map, references to them survive later insertions.
+ */
+template <class T>
+class StatementMap
+{
+public:
+	// like std::map::operator[], default-construct the value if absent
+	T &operator[](const Statement *s);
+
+	std::size_t slots(void) const { return stms_.size(); }
+	const Statement *stm(std::size_t i) const { return stms_[i]; }
+	T &value(std::size_t i) { return values_[i]; }
+	const T &value(std::size_t i) const { return values_[i]; }
+
+private:
+	std::vector<const Statement *> stms_;
+	std::deque<T> values_;
+};
+
+template <class T>
+T &
+StatementMap<T>::operator[](const Statement *s)
+{
+	assert(s);
+	std::size_t i = s->get_func_stm_id();
+	if (i >= stms_.size()) {
+		stms_.resize(i + 1, 0);
+		values_.resize(i + 1);
+	}
+	if (stms_[i] == 0) {
+		stms_[i] = s;
+	}
+	// ids are only unique inside a function
+	assert(stms_[i] == s);
+	return values_[i];
+}
+
+#endif // STATEMENT_MAP_H
@@ -63,17 +63,24 @@ using namespace std;
 /*
  *
  */
-const Type *Type::simple_types[MAX_SIMPLE_TYPES];
+thread_local const Type *Type::simple_types[MAX_SIMPLE_TYPES];
 
-Type *Type::void_type = NULL;
+thread_local Type *Type::void_type = NULL;
 
 // ---------------------------------------------------------------------
 // List of all types used in the program
-static vector<Type *> AllTypes;
-static vector<Type *> derived_types;
+static thread_local vector<Type *> AllTypes;
+static thread_local vector<Type *> derived_types;
 
-AttributeGenerator struct_type_attr_generator;
-AttributeGenerator union_type_attr_generator;
+// Sequence number used to name struct and union types
+static thread_local unsigned int struct_union_sequence = 0;
+static thread_local unsigned int type_sequence = 0;
+
+// match_table[a->tid][b->tid] caches a->match(b, mt) for every eMatchType
+static thread_local vector<vector<unsigned char> > match_table;
+
+static thread_local AttributeGenerator struct_type_attr_generator;
+static thread_local AttributeGenerator union_type_attr_generator;
 
 //////////////////////////////////////////////////////////////////////
 
@@ -307,6 +314,7 @@ Type::Type(eSimpleType simple_type) :
 	ptr_type(0),
 	simple_type(simple_type),
 	sid(0), // not used for simple types
+	tid(type_sequence++),
 	used(false),
 	printed(false),
 	packed_(false),
@@ -324,6 +332,7 @@ Type::Type(vector<const Type*>& struct_fields, bool isStruct, bool packed,
     ptr_type(0),
     simple_type(MAX_SIMPLE_TYPES), // not a valid simple type
     fields(struct_fields),
+    tid(type_sequence++),
     used(false),
     printed(false),
     packed_(packed),
@@ -332,12 +341,11 @@ Type::Type(vector<const Type*>& struct_fields, bool isStruct, bool packed,
     qfers_(qfers),
     bitfields_length_(fields_length)
 {
-    static unsigned int sequence = 0;
 	if (isStruct)
         eType = eStruct;
     else
         eType = eUnion;
-    sid =  sequence++;
+    sid =  struct_union_sequence++;
 }
 
 // --------------------------------------------------------------
@@ -347,6 +355,7 @@ Type::Type(const Type* t) :
     eType(ePointer),
     ptr_type(t),
     simple_type(MAX_SIMPLE_TYPES), // not a valid simple type
+    tid(type_sequence++),
     used(false),
     printed(false),
     packed_(false),
@@ -384,7 +393,7 @@ Type::operator=(const Type& t)
 const Type &
 Type::get_simple_type(eSimpleType st)
 {
-	static bool inited = false;
+	static thread_local bool inited = false;
 
 	assert(st != MAX_SIMPLE_TYPES);
 
@@ -1559,18 +1568,38 @@ Type::needs_cast(const Type* t) const
 	return (eType == ePointer) && !get_base_type()->is_equivalent(t->get_base_type());
 }
 
+/*
+ * Types never change once created, so the result of every match type is
+ * computed on the first query for a pair of types and looked up after.
+ */
+#define MATCH_KNOWN 0x80
+
 bool
 Type::match(const Type* t, enum eMatchType mt) const
 {
-	switch (mt) {
-	case eExact: return (this == t);
-	case eConvert: return is_convertable(t);
-	case eDereference: return is_dereferenced_from(t);
-	case eDerefExact: return (t == this || is_dereferenced_from(t));
-	case eFlexible: return is_derivable(t);
-	default: break;
-	}
-	return false;
+	if (mt == eExact)
+		return (this == t);
+	if (match_table.size() <= tid)
+		match_table.resize(type_sequence);
+	vector<unsigned char>& row = match_table[tid];
+	if (row.size() <= t->tid)
+		row.resize(type_sequence, 0);
+	unsigned char& matches = row[t->tid];
+	if (!matches) {
+		bool deref = is_dereferenced_from(t);
+		matches = MATCH_KNOWN;
+		if (this == t)
+			matches |= 1 << eExact;
+		if (is_convertable(t))
+			matches |= 1 << eConvert;
+		if (deref)
+			matches |= 1 << eDereference;
+		if (t == this || deref)
+			matches |= 1 << eDerefExact;
+		if (is_derivable(t))
+			matches |= 1 << eFlexible;
+	}
+	return (matches & (1 << mt)) != 0;
 }
 
 // ---------------------------------------------------------------------
@@ -2036,6 +2065,17 @@ Type::doFinalization(void)
 	for(j = derived_types.begin(); j != derived_types.end(); ++j)
 		delete (*j);
 	derived_types.clear();
+
+	for (int i = 0; i < MAX_SIMPLE_TYPES; ++i) {
+		Type::simple_types[i] = 0;
+	}
+	delete Type::void_type;
+	Type::void_type = NULL;
+	struct_union_sequence = 0;
+	type_sequence = 0;
+	match_table.clear();
+	struct_type_attr_generator.clear();
+	union_type_attr_generator.clear();
 }
 
 
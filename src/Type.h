@@ -278,6 +278,7 @@ public:
 	vector<unsigned int> dimensions;    // for array types
 	vector<const Type*> fields;         // for struct/union types
 	unsigned int sid;                   // sequence id, for struct/union types
+	const unsigned int tid;             // sequence id over all types, indexes the match table
 
 	bool used;                          // whether any variable declared with this type
 	bool printed;                       // whether this struct/union has been printed in the random program
@@ -292,11 +293,11 @@ public:
 					// need of struct's level type qualifiers.
 	vector<int> bitfields_length_;		// -1 means it's a regular field
 
-	static Type *void_type;
+	static thread_local Type *void_type;
 private:
 	DISALLOW_COPY_AND_ASSIGN(Type);
 
-	static const Type *simple_types[MAX_SIMPLE_TYPES];
+	static thread_local const Type *simple_types[MAX_SIMPLE_TYPES];
 
 	// Package init.
 	friend void GenerateAllTypes(void);
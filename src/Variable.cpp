@@ -73,13 +73,16 @@
 
 
 using namespace std;
-std::vector< std::vector<const Variable*>* > Variable::ctrl_vars_vectors;
-unsigned long Variable::ctrl_vars_count;
+thread_local std::vector< std::vector<const Variable*>* > Variable::ctrl_vars_vectors;
+thread_local unsigned long Variable::ctrl_vars_count;
+thread_local int Variable::next_id = Variable::static_id_count;
+thread_local BitSet Variable::used_ids;
+int Variable::next_static_id = 0;
 
 const char Variable::sink_var_name[] = "csmith_sink_";
 
-bool Variable::var_attr_generate = false;
-AttributeGenerator Variable::var_attr_generator;
+thread_local bool Variable::var_attr_generate = false;
+thread_local AttributeGenerator Variable::var_attr_generator;
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -454,7 +457,8 @@ Variable::Variable(const std::string &name, const Type *type,
 	  isAuto(isAuto), isStatic(isStatic), isRegister(isRegister),
 	  isBitfield_(isBitfield), isAddrTaken(false), isAccessOnce(false),
 	  field_var_of(isFieldVarOf), isArray(false),
-	  qfer(isConsts, isVolatiles)
+	  qfer(isConsts, isVolatiles),
+	  id(new_id())
 {
 	// nothing else to do
 }
@@ -468,7 +472,8 @@ Variable::Variable(const std::string &name, const Type *type, const Expression*
 	  isAuto(false), isStatic(false), isRegister(false), isBitfield_(false),
 	  isAddrTaken(false), isAccessOnce(false),
 	  field_var_of(0), isArray(false),
-	  qfer(*qfer)
+	  qfer(*qfer),
+	  id(new_id())
 {
 	// nothing else to do
 }
@@ -480,11 +485,53 @@ Variable::Variable(const std::string &name, const Type *type, const Expression*
 	  isAddrTaken(false), isAccessOnce(false),
 	  field_var_of(isFieldVarOf),
 	  isArray(isArray),
-	  qfer(*qfer)
+	  qfer(*qfer),
+	  id(new_id())
 {
 	// nothing else to do
 }
 
+/*
+ * A dummy variable made during static initialization, with an id reserved
+ * for it
+ */
+Variable::Variable(const std::string &name, const CVQualifiers* qfer, int id)
+	: name(name), type(0),
+	  init(0),
+	  isAuto(false), isStatic(false), isRegister(false), isBitfield_(false),
+	  isAddrTaken(false), isAccessOnce(false),
+	  field_var_of(0), isArray(false),
+	  qfer(*qfer),
+	  id(id)
+{
+	// nothing else to do
+}
+
+/*
+ * Ids index the Effect and FactMgr bitsets, so no two variables of a
+ * program may share one, and none may take an id of a static dummy
+ */
+int
+Variable::new_id(void)
+{
+	int id = next_id++;
+	assert(id >= static_id_count);
+	assert(!used_ids.test(id));
+	used_ids.set(id);
+	return id;
+}
+
+/*
+ * Static initialization runs before any other thread starts, so the
+ * counter needs no lock
+ */
+int
+Variable::new_static_id(void)
+{
+	assert(next_static_id < static_id_count);
+	return next_static_id++;
+}
+
 /*
  *
  */
@@ -878,6 +925,11 @@ Variable::doFinalization(void)
 		delete v;
 	}
 	ctrl_vars_vectors.clear();
+	ctrl_vars_count = 0;
+	next_id = static_id_count;
+	used_ids.clear();
+	var_attr_generator.clear();
+	var_attr_generate = false;
 }
 
 // --------------------------------------------------------------
@@ -1012,17 +1064,17 @@ Variable::hash(std::ostream& out) const
                 Output(out);
                 out << ", sizeof(";
                 Output(out);
-                out << "), \"" << name << "\", print_hash_value);" << endl;
+                out << "), \"" << name << "\", print_hash_value);" << '\n';
             } else {
                 out << "    transparent_crc(";
                 Output(out);
-                out << ", \"" << name << "\", print_hash_value);" << endl;
+                out << ", \"" << name << "\", print_hash_value);" << '\n';
             }
 		}
 		else {
 			out << "    " << Variable::sink_var_name << " = ";
 			Output(out);
-			out << ";" << endl;
+			out << ";" << '\n';
 		}
     }
 	else if (type->eType == ePointer) {
@@ -1105,7 +1157,7 @@ Variable::output_runtime_value(ostream &out, string prefix, string suffix, int i
 
 	output_tab(out, indent);
 	if (multi_lines) {
-		out << "printf(\"" << prefix << "\");" << endl;
+		out << "printf(\"" << prefix << "\");" << '\n';
 		output_tab(out, indent);
 		out << "printf(\"" << directive << suffix << "\", " << to_string() <<");";
 	}
@@ -157,13 +157,18 @@ public:
 	const Variable* field_var_of; //expanded from a struct/union
 	const bool isArray;
 	const CVQualifiers qfer;
+	const int id;	// dense per-program id, used to index fact environments
+
+	// ids below this are for the dummy variables made during static
+	// initialization, which all programs and threads share
+	static const int static_id_count = 16;
 	static std::vector<const Variable*> &get_new_ctrl_vars();
 	static std::vector<const Variable*> &get_last_ctrl_vars();
 
 	static const char sink_var_name[];
 
-	static bool var_attr_generate;
-	static AttributeGenerator var_attr_generator;
+	static thread_local bool var_attr_generate;
+	static thread_local AttributeGenerator var_attr_generator;
 
 private:
 	Variable(const std::string &name, const Type *type, const Expression* init, const CVQualifiers* qfer);
@@ -171,10 +176,17 @@ private:
 	Variable(const std::string &name, const Type *type,
 			 const vector<bool>& isConsts, const vector<bool>& isVolatiles,
 			 bool isAuto, bool isStatic, bool isRegister, bool isBitfield, const Variable* isFieldVarOf);
+	Variable(const std::string &name, const CVQualifiers* qfer, int id);
+
+	static int new_id(void);
+	static int new_static_id(void);
 
 	static std::vector<const Variable*>& new_ctrl_vars(void);
-	static std::vector< std::vector<const Variable*>* > ctrl_vars_vectors;
-	static unsigned long ctrl_vars_count;
+	static thread_local std::vector< std::vector<const Variable*>* > ctrl_vars_vectors;
+	static thread_local unsigned long ctrl_vars_count;
+	static thread_local int next_id;
+	static thread_local BitSet used_ids;
+	static int next_static_id;
 
 	void create_field_vars(const Type* type);
 };
@@ -0,0 +1,100 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#if HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "VariableIndex.h"
+
+#include <algorithm>
+#include "Type.h"
+#include "Variable.h"
+
+/*
+ * index the variables appended to the scope since the last sync
+ */
+void
+VariableIndex::sync(const std::vector<Variable *> &vars)
+{
+	if (vars.size() < vars_.size())
+		clear();
+	for (std::size_t i = vars_.size(); i < vars.size(); i++) {
+		Variable* var = vars[i];
+		std::size_t j;
+		for (j = 0; j < buckets_.size(); j++) {
+			if (buckets_[j].type == var->type)
+				break;
+		}
+		if (j == buckets_.size()) {
+			Bucket b;
+			b.type = var->type;
+			buckets_.push_back(b);
+		}
+		buckets_[j].positions.push_back(i);
+		vars_.push_back(var);
+	}
+}
+
+/*
+ * Append to "vars" every variable that could match "type" under any match
+ * type, i.e. whose type is derivable from "type".  If "expand_aggregates" is
+ * set, struct/union variables of other types are appended to "aggregates"
+ * instead, for the caller to break into fields.  Both lists keep the order
+ * of the scope.
+ */
+void
+VariableIndex::find_compatible_vars(const Type* type, bool expand_aggregates,
+		std::vector<Variable *> &vars, std::vector<Variable *> &aggregates) const
+{
+	std::vector<std::size_t> var_pos, aggregate_pos;
+	for (std::size_t i = 0; i < buckets_.size(); i++) {
+		const Bucket& b = buckets_[i];
+		bool compatible = type->match(b.type, eFlexible);
+		if (expand_aggregates && b.type->is_aggregate() && b.type != type) {
+			for (std::size_t j = 0; j < b.positions.size(); j++) {
+				std::size_t pos = b.positions[j];
+				// virtual variables are never broken up
+				if (!vars_[pos]->is_virtual())
+					aggregate_pos.push_back(pos);
+				else if (compatible)
+					var_pos.push_back(pos);
+			}
+		}
+		else if (compatible) {
+			var_pos.insert(var_pos.end(), b.positions.begin(), b.positions.end());
+		}
+	}
+	std::sort(var_pos.begin(), var_pos.end());
+	std::sort(aggregate_pos.begin(), aggregate_pos.end());
+	for (std::size_t i = 0; i < var_pos.size(); i++)
+		vars.push_back(vars_[var_pos[i]]);
+	for (std::size_t i = 0; i < aggregate_pos.size(); i++)
+		aggregates.push_back(vars_[aggregate_pos[i]]);
+}
@@ -0,0 +1,69 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef VARIABLE_INDEX_H
+#define VARIABLE_INDEX_H
+
+#include <cstddef>
+#include <vector>
+
+class Type;
+class Variable;
+
+/*
+ * An index over one scope's list of variables (the globals, a block's
+ * locals or a function's parameters), bucketed by variable type.  Scopes
+ * only ever grow, so the index catches up with its list incrementally
+ * whenever it is synced.  Lookups return variables in list order, which
+ * keeps selection from the index identical to a scan of the list.
+ */
+class VariableIndex
+{
+public:
+	void sync(const std::vector<Variable *> &vars);
+
+	void find_compatible_vars(const Type* type, bool expand_aggregates,
+			std::vector<Variable *> &vars, std::vector<Variable *> &aggregates) const;
+
+	void find_all_vars(std::vector<Variable *> &vars) const { vars.insert(vars.end(), vars_.begin(), vars_.end()); }
+
+	void clear(void) { vars_.clear(); buckets_.clear(); }
+
+private:
+	struct Bucket {
+		const Type* type;
+		std::vector<std::size_t> positions;
+	};
+
+	std::vector<Variable *> vars_;
+
+	std::vector<Bucket> buckets_;
+};
+
+#endif // VARIABLE_INDEX_H
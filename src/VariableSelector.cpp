@@ -65,6 +65,7 @@
 #include "Probabilities.h"
 #include "ProbabilityTable.h"
 #include "StringUtils.h"
+#include "VariableIndex.h"
 
 using namespace std;
 
@@ -72,10 +73,12 @@ using namespace std;
 
 // --------------------------------------------------------------
 // static variables
-vector<Variable*> VariableSelector::AllVars;
-vector<Variable*> VariableSelector::GlobalList;
-vector<Variable*> VariableSelector::GlobalNonvolatilesList;
-bool VariableSelector::var_created = false;
+thread_local vector<Variable*> VariableSelector::AllVars;
+thread_local vector<Variable*> VariableSelector::GlobalList;
+thread_local vector<Variable*> VariableSelector::GlobalNonvolatilesList;
+thread_local VariableIndex VariableSelector::GlobalIndex;
+thread_local VariableIndex VariableSelector::GlobalNonvolatilesIndex;
+thread_local bool VariableSelector::var_created = false;
 
 class VariableSelectFilter : public Filter
 {
@@ -221,7 +224,7 @@ VariableSelector::has_dereferenceable_var(const vector<Variable *>& vars, const
 	FactMgr* fm = get_fact_mgr(&cg_context);
 	for (size_t i=0; i<vars.size(); i++) {
 		Variable* var = vars[i];
-		if (type->is_dereferenced_from(var->type) && FactPointTo::is_valid_ptr(var, fm->global_facts)) {
+		if (type->match(var->type, eDereference) && FactPointTo::is_valid_ptr(var, fm->global_facts)) {
 			return true;
 		}
 	}
@@ -421,12 +424,74 @@ VariableSelector::choose_var(vector<Variable *> vars,
 		   bool no_bitfield,
 		   bool no_expand_struct_union)
 {
-	vector<Variable *> ok_vars;
-	vector<Variable *>::iterator i;
-
 	if (!no_expand_struct_union && type && (type->eType == eSimple || type->is_aggregate()))
 		expand_struct_union_vars(vars, type);
 
+	return choose_compatible_var(vars, access, cg_context, type, qfer, mt, invalid_vars, no_bitfield);
+}
+
+/*
+ * Same as above, but choose from the concatenation of the indexed scopes.
+ * Only the variables whose types are compatible with "type" are looked at;
+ * they come out of the indexes in the order a scan of the scopes and
+ * expand_struct_union_vars would produce, so the choice is the same.
+ */
+Variable *
+VariableSelector::choose_var(const vector<VariableIndex *>& scopes,
+		   Effect::Access access,
+		   const CGContext &cg_context,
+		   const Type* type,
+		   const CVQualifiers* qfer,
+		   eMatchType mt,
+		   const vector<const Variable*>& invalid_vars,
+		   bool no_bitfield,
+		   bool no_expand_struct_union)
+{
+	size_t i;
+	vector<Variable *> vars;
+	if (!type) {
+		for (i=0; i<scopes.size(); i++) {
+			scopes[i]->find_all_vars(vars);
+		}
+		return choose_var(vars, access, cg_context, type, qfer, mt, invalid_vars, no_bitfield, no_expand_struct_union);
+	}
+
+	bool expand = !no_expand_struct_union && (type->eType == eSimple || type->is_aggregate());
+	vector<Variable *> aggregates;
+	for (i=0; i<scopes.size(); i++) {
+		scopes[i]->find_compatible_vars(type, expand, vars, aggregates);
+	}
+	// fields are appended after all the scopes, as by expand_struct_union_vars
+	if (!aggregates.empty()) {
+		vector<Variable *> fields;
+		for (i=0; i<aggregates.size(); i++) {
+			fields.insert(fields.end(), aggregates[i]->field_vars.begin(), aggregates[i]->field_vars.end());
+		}
+		expand_struct_union_vars(fields, type);
+		for (i=0; i<fields.size(); i++) {
+			if (type->match(fields[i]->type, eFlexible))
+				vars.push_back(fields[i]);
+		}
+	}
+	return choose_compatible_var(vars, access, cg_context, type, qfer, mt, invalid_vars, no_bitfield);
+}
+
+/*
+ * choose from the already expanded "vars"
+ */
+Variable *
+VariableSelector::choose_compatible_var(const vector<Variable *>& vars,
+		   Effect::Access access,
+		   const CGContext &cg_context,
+		   const Type* type,
+		   const CVQualifiers* qfer,
+		   eMatchType mt,
+		   const vector<const Variable*>& invalid_vars,
+		   bool no_bitfield)
+{
+	vector<Variable *> ok_vars;
+	vector<Variable *>::const_iterator i;
+
 	bool found = has_dereferenceable_var(vars, type, cg_context);
 	if (found) {
 		Bookkeeper::pointer_avail_for_dereference++;
@@ -528,7 +593,7 @@ VariableSelector::create_and_initialize(Effect::Access access, const CGContext &
 	return var;
 }
 
-static int tmp_count = 0;
+static thread_local int tmp_count = 0;
 // --------------------------------------------------------------
  /* Parameter "type"
  * 0 --- To generate any type
@@ -619,7 +684,8 @@ VariableSelector::eager_create_global_struct(Effect::Access access, const CGCont
 		return NULL;
 
 	ERROR_GUARD(NULL);
-	return choose_var(GlobalList, access, cg_context, type, qfer, mt, invalid_vars);
+	vector<VariableIndex *> scopes(1, get_global_index());
+	return choose_var(scopes, access, cg_context, type, qfer, mt, invalid_vars);
 }
 
 Variable*
@@ -653,7 +719,9 @@ VariableSelector::eager_create_local_struct(Block &block, Effect::Access access,
 		return NULL;
 
 	ERROR_GUARD(NULL);
-	return choose_var(block.local_vars, access, cg_context, type, qfer, mt, invalid_vars);
+	block.local_var_index.sync(block.local_vars);
+	vector<VariableIndex *> scopes(1, &block.local_var_index);
+	return choose_var(scopes, access, cg_context, type, qfer, mt, invalid_vars);
 }
 
 
@@ -662,7 +730,8 @@ VariableSelector::eager_create_local_struct(Block &block, Effect::Access access,
 Variable *
 VariableSelector::SelectGlobal(Effect::Access access, const CGContext &cg_context, const Type* type, const CVQualifiers* qfer, eMatchType mt, const vector<const Variable*>& invalid_vars)
 {
-	Variable* var = choose_var(GlobalList, access, cg_context, type, qfer, mt, invalid_vars);
+	vector<VariableIndex *> scopes(1, get_global_index());
+	Variable* var = choose_var(scopes, access, cg_context, type, qfer, mt, invalid_vars);
 	ERROR_GUARD(NULL);
 	if (var == 0) {
 		if (CGOptions::expand_struct()) {
@@ -756,6 +825,31 @@ VariableSelector::find_all_visible_vars(const Block* b)
 	return vars;
 }
 
+VariableIndex *
+VariableSelector::get_global_index(void)
+{
+	GlobalIndex.sync(GlobalList);
+	return &GlobalIndex;
+}
+
+VariableIndex *
+VariableSelector::get_global_nonvolatiles_index(void)
+{
+	GlobalNonvolatilesIndex.sync(GlobalNonvolatilesList);
+	return &GlobalNonvolatilesIndex;
+}
+
+/* append the indexes of the locals visible at block b, innermost first */
+void
+VariableSelector::find_visible_local_scopes(const Block* b, vector<VariableIndex *>& scopes)
+{
+	while (b) {
+		b->local_var_index.sync(b->local_vars);
+		scopes.push_back(&b->local_var_index);
+		b = b->parent;
+	}
+}
+
 /*
  * enlarge the block to contains both src and dest of jump edges, if there are
  * some destinations in this block. This is used to create a local variable
@@ -841,19 +935,20 @@ VariableSelector::make_init_value(Effect::Access access, const CGContext &cg_con
 	const Type* type = t->ptr_type;
 	assert(type);
 
-	vector<Variable*> vars = find_all_visible_vars(b);
+	vector<VariableIndex *> scopes(1, get_global_index());
+	find_visible_local_scopes(b, scopes);
 	vector<const Variable*> dummy;
 
 	Variable *var = NULL;
 	// b == NULL means we are generating init for globals
 	if (!b && CGOptions::ccomp()) {
 		get_all_array_vars(dummy);
-		var = choose_var(vars, access, cg_context, type, &qfer, eExact, dummy, true, true);
+		var = choose_var(scopes, access, cg_context, type, &qfer, eExact, dummy, true, true);
 	}
 	else {
 		if (!CGOptions::addr_taken_of_locals())
 			get_all_local_vars(b, dummy);
-		var = choose_var(vars, access, cg_context, type, &qfer, eExact, dummy, true);
+		var = choose_var(scopes, access, cg_context, type, &qfer, eExact, dummy, true);
 	}
 	ERROR_GUARD(NULL);
 
@@ -1014,7 +1109,9 @@ VariableSelector::SelectParentLocal(Effect::Access access,
 		ERROR_GUARD(NULL);
 	}
 
-	Variable* var = choose_var(block->local_vars, access, cg_context, t, qfer, mt, invalid_vars);
+	block->local_var_index.sync(block->local_vars);
+	vector<VariableIndex *> scopes(1, &block->local_var_index);
+	Variable* var = choose_var(scopes, access, cg_context, t, qfer, mt, invalid_vars);
 	ERROR_GUARD(NULL);
 	if (var == 0) {
 #if 0
@@ -1074,7 +1171,9 @@ VariableSelector::SelectParentParam(Effect::Access access,
 	Function &parent = *cg_context.get_current_func();
 	if (parent.param.empty())
 		return SelectParentLocal(access, cg_context, type, qfer, mt, invalid_vars);
-	Variable* var = choose_var(parent.param, access, cg_context, type, qfer, mt, invalid_vars);
+	parent.param_index.sync(parent.param);
+	vector<VariableIndex *> scopes(1, &parent.param_index);
+	Variable* var = choose_var(scopes, access, cg_context, type, qfer, mt, invalid_vars);
 	ERROR_GUARD(NULL);
 	return var ? var : SelectParentLocal(access, cg_context, type, qfer, mt, invalid_vars);
 }
@@ -1242,20 +1341,17 @@ Variable *
 VariableSelector::select_deref_pointer(Effect::Access access, const CGContext &cg_context, const Type* type, const CVQualifiers* qfer, const vector<const Variable*>& invalid_vars)
 {
 	assert(qfer && qfer->sanity_check(type));
-	vector<Variable*> vars;
+	vector<VariableIndex *> scopes;
 	// add globals
-	vars.insert(vars.end(), GlobalNonvolatilesList.begin(), GlobalNonvolatilesList.end());
+	scopes.push_back(get_global_nonvolatiles_index());
 	// add parent locals
-	const Block* b = cg_context.get_current_block();
-	while (b) {
-		vars.insert(vars.end(), b->local_vars.begin(), b->local_vars.end());
-		b = b->parent;
-	}
+	find_visible_local_scopes(cg_context.get_current_block(), scopes);
 	// add function parameters
 	const Function* f = cg_context.get_current_func();
-	vars.insert(vars.end(), f->param.begin(), f->param.end());
+	f->param_index.sync(f->param);
+	scopes.push_back(&f->param_index);
 
-	Variable* var = choose_var(vars, access, cg_context, type, qfer, eDereference, invalid_vars);
+	Variable* var = choose_var(scopes, access, cg_context, type, qfer, eDereference, invalid_vars);
 	if (var == 0) {
 		Type* ptr_type = 0;
 		if (type->get_indirect_level() < CGOptions::max_indirect_level()) {
@@ -1523,7 +1619,7 @@ Variable *
 VariableSelector::make_dummy_static_variable(const string &name)
 {
 	CVQualifiers dummy;
-	Variable *var = new Variable(name, 0, 0, &dummy);
+	Variable *var = new Variable(name, &dummy, Variable::new_static_id());
 	return var;
 }
 
@@ -1554,6 +1650,8 @@ VariableSelector::doFinalization(void)
 	AllVars.clear();
 	GlobalList.clear();
 	GlobalNonvolatilesList.clear();
+	GlobalIndex.clear();
+	GlobalNonvolatilesIndex.clear();
 }
 
 // --------------------------------------------------------------
@@ -1562,11 +1660,11 @@ OutputGlobalVariables(std::ostream &out)
 {
 	output_comment_line(out, "--- GLOBAL VARIABLES ---");
 	vector<Variable *>& vars = *(VariableSelector::GetGlobalVariables());
-	bool access_once = CGOptions::access_once();
+	bool suppress = CGOptions::suppress_access_once();
 
-	CGOptions::access_once(false);
+	CGOptions::suppress_access_once(true);
 	OutputVariableList(vars, out);
-	CGOptions::access_once(access_once);
+	CGOptions::suppress_access_once(suppress);
 }
 
 void
@@ -1574,10 +1672,10 @@ OutputGlobalVariablesDecls(std::ostream &out, std::string prefix)
 {
 	output_comment_line(out, "--- GLOBAL VARIABLES ---");
 
-	bool access_once = CGOptions::access_once();
-	CGOptions::access_once(false);
+	bool suppress = CGOptions::suppress_access_once();
+	CGOptions::suppress_access_once(true);
 	OutputVariableDeclList(*VariableSelector::GetGlobalVariables(), out, prefix);
-	CGOptions::access_once(access_once);
+	CGOptions::suppress_access_once(suppress);
 }
 
 void
@@ -46,6 +46,7 @@ class Lhs;
 class Fact;
 class CVQualifiers;
 class ArrayVariable;
+class VariableIndex;
 
 enum eVariableScope
 {
@@ -143,6 +144,20 @@ private:
 
 	static void expand_struct_union_vars(vector<Variable *>& vars, const Type* type);
 
+	static Variable* choose_var(const vector<VariableIndex *>& scopes, Effect::Access access,
+		   const CGContext &cg_context, const Type* type, const CVQualifiers* qfer,
+		   eMatchType mt, const vector<const Variable*>& invalid_vars, bool no_bitfield = false, bool no_expand_struct = false);
+
+	static Variable* choose_compatible_var(const vector<Variable *>& vars, Effect::Access access,
+		   const CGContext &cg_context, const Type* type, const CVQualifiers* qfer,
+		   eMatchType mt, const vector<const Variable*>& invalid_vars, bool no_bitfield);
+
+	static VariableIndex* get_global_index(void);
+
+	static VariableIndex* get_global_nonvolatiles_index(void);
+
+	static void find_visible_local_scopes(const Block* b, vector<VariableIndex *>& scopes);
+
 	static bool has_dereferenceable_var(const vector<Variable *>& vars, const Type* type, const CGContext& cg_context);
 
 	static bool has_eligible_volatile_var(const vector<Variable *>& vars, const Type* type, const CVQualifiers* qfer, Effect::Access access, const CGContext& cg_context);
@@ -153,16 +168,20 @@ private:
 					const CVQualifiers* qfer, Block *blk, std::string name);
 
 	// all variables generated
-	static vector<Variable*> AllVars;
+	static thread_local vector<Variable*> AllVars;
 
 	// All globals, including volatiles.
-	static vector<Variable*> GlobalList;
+	static thread_local vector<Variable*> GlobalList;
 
 	// All the non-volatile globals.
-	static vector<Variable*> GlobalNonvolatilesList;
+	static thread_local vector<Variable*> GlobalNonvolatilesList;
+
+	// GlobalList and GlobalNonvolatilesList bucketed by type.
+	static thread_local VariableIndex GlobalIndex;
+	static thread_local VariableIndex GlobalNonvolatilesIndex;
 
 	// flag that indicates whether a new variable has been created
-	static bool var_created;
+	static thread_local bool var_created;
 };
 
 void OutputGlobalVariables(std::ostream &);
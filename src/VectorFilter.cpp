@@ -77,6 +77,31 @@ VectorFilter::filter(int v) const
 	return (flag_ == FILTER_OUT) ? re : !re;
 }
 
+/*
+ * Collect the values in [0, n) that are not filtered out from the listed
+ * items, or from the probability table they are looked up in.
+ */
+bool
+VectorFilter::get_admissible_values(unsigned int n, std::vector<unsigned int> &vals) const
+{
+	bool admit_listed = (flag_ != FILTER_OUT);
+	if (!this->valid_filter()) {
+		for (unsigned int v = 0; v < n; v++)
+			vals.push_back(v);
+	}
+	else if (ptable) {
+		ptable->get_rnd_nums(vs_, admit_listed, n, vals);
+	}
+	else {
+		for (unsigned int v = 0; v < n; v++) {
+			bool listed = std::find(vs_.begin(), vs_.end(), v) != vs_.end();
+			if (listed == admit_listed)
+				vals.push_back(v);
+		}
+	}
+	return true;
+}
+
 VectorFilter&
 VectorFilter::add(unsigned int item)
 {
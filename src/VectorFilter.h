@@ -57,6 +57,8 @@ public:
 	virtual ~VectorFilter(void);
 
 	virtual bool filter(int v) const;
+
+	virtual bool get_admissible_values(unsigned int n, std::vector<unsigned int> &vals) const;
 private:
 	std::vector<unsigned int> vs_;
 
@@ -0,0 +1,127 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#if HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "Xoshiro256.h"
+
+#include <cstring>
+
+namespace {
+
+/*
+ * A linear map on the 256-bit state, as the images of the 256 unit
+ * vectors.  Bit j of the state is bit (j % 64) of word (j / 64).
+ */
+struct StateMatrix {
+	uint64_t col[256][4];
+
+	void apply(const uint64_t in[4], uint64_t out[4]) const
+	{
+		uint64_t r[4] = {0, 0, 0, 0};
+		for (int j = 0; j < 256; j++) {
+			if ((in[j / 64] >> (j % 64)) & 1) {
+				for (int w = 0; w < 4; w++)
+					r[w] ^= col[j][w];
+			}
+		}
+		memcpy(out, r, sizeof(r));
+	}
+
+	void square(void)
+	{
+		StateMatrix m = *this;
+		for (int j = 0; j < 256; j++)
+			m.apply(m.col[j], col[j]);
+	}
+};
+
+/*
+ * jump[k] advances the generator by 2^(128 + k) steps, which are stream
+ * strides 2^k.
+ */
+struct JumpTable {
+	StateMatrix jump[64];
+
+	JumpTable(void)
+	{
+		// the transition matrix, from one step of each unit vector
+		StateMatrix &m = jump[0];
+		for (int j = 0; j < 256; j++) {
+			uint64_t *s = m.col[j];
+			s[0] = s[1] = s[2] = s[3] = 0;
+			s[j / 64] = (uint64_t)1 << (j % 64);
+			const uint64_t t = s[1] << 17;
+			s[2] ^= s[0];
+			s[3] ^= s[1];
+			s[1] ^= s[2];
+			s[0] ^= s[3];
+			s[2] ^= t;
+			s[3] = (s[3] << 45) | (s[3] >> 19);
+		}
+		for (int i = 0; i < 128; i++)
+			m.square();
+		for (int k = 1; k < 64; k++) {
+			jump[k] = jump[k - 1];
+			jump[k].square();
+		}
+	}
+};
+
+uint64_t
+splitmix64(uint64_t &x)
+{
+	uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return z ^ (z >> 31);
+}
+
+} // namespace
+
+/*
+ * Start stream <stream>: stream 0 is the state seeded from splitmix64(0),
+ * advanced by 2^128 steps for each unit of <stream>.
+ */
+void
+Xoshiro256::seed_stream(uint64_t stream)
+{
+	// built once, on first use, by whichever thread gets here first
+	static const JumpTable table;
+
+	uint64_t x = 0;
+	for (int w = 0; w < 4; w++)
+		s_[w] = splitmix64(x);
+	for (int k = 0; k < 64; k++) {
+		if ((stream >> k) & 1)
+			table.jump[k].apply(s_, s_);
+	}
+}
@@ -0,0 +1,67 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef XOSHIRO256_H
+#define XOSHIRO256_H
+
+#include <stdint.h>
+
+/*
+ * The xoshiro256** generator of Blackman and Vigna.  Its period is
+ * 2^256 - 1, and its state transition is linear, so the generator can be
+ * advanced by any number of steps with precomputed powers of the
+ * transition matrix.  Stream n starts n * 2^128 steps after the start of
+ * stream 0, so two streams never overlap unless a program draws 2^128
+ * numbers.
+ */
+class Xoshiro256
+{
+public:
+	void seed_stream(uint64_t stream);
+
+	uint64_t next(void)
+	{
+		const uint64_t result = rotl(s_[1] * 5, 7) * 9;
+		const uint64_t t = s_[1] << 17;
+		s_[2] ^= s_[0];
+		s_[3] ^= s_[1];
+		s_[1] ^= s_[2];
+		s_[0] ^= s_[3];
+		s_[2] ^= t;
+		s_[3] = rotl(s_[3], 45);
+		return result;
+	}
+
+private:
+	static uint64_t rotl(const uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+	uint64_t s_[4];
+};
+
+#endif // XOSHIRO256_H
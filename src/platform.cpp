@@ -137,6 +137,105 @@ bool create_dir(const char *dir)
 	return true;
 }
 
+//////////// platform specific fork /////////////////
+
+#ifndef WIN32
+#  include <sys/wait.h>
+#endif
+
+// Return 0 in the child, the id of the child in the parent, or -1 if no
+// child could be created.
+long platform_fork()
+{
+#ifndef WIN32
+	return fork();
+#else
+	return -1;
+#endif
+}
+
+// Wait for the child <pid>, and return true if it exited normally with
+// status 0.
+bool platform_wait(long pid)
+{
+#ifndef WIN32
+	int status;
+	if (waitpid(pid, &status, 0) == -1)
+		return false;
+	return WIFEXITED(status) && (WEXITSTATUS(status) == 0);
+#else
+	return false;
+#endif
+}
+
+// End a forked child without running the exit handlers or flushing the
+// stdio buffers it shares with its parent.
+void platform_exit(int status)
+{
+#ifndef WIN32
+	_exit(status);
+#else
+	exit(status);
+#endif
+}
+
+// Create a pipe, reading from fds[0] and writing to fds[1].
+bool platform_pipe(int fds[2])
+{
+#ifndef WIN32
+	return pipe(fds) == 0;
+#else
+	return false;
+#endif
+}
+
+// Write all <len> bytes of <buf> to <fd>.
+bool platform_write(int fd, const void *buf, unsigned long len)
+{
+#ifndef WIN32
+	const char *p = static_cast<const char *>(buf);
+	while (len > 0) {
+		ssize_t n = write(fd, p, len);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return false;
+		p += n;
+		len -= n;
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
+// Read exactly <len> bytes from <fd> into <buf>.
+bool platform_read(int fd, void *buf, unsigned long len)
+{
+#ifndef WIN32
+	char *p = static_cast<char *>(buf);
+	while (len > 0) {
+		ssize_t n = read(fd, p, len);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return false;
+		p += n;
+		len -= n;
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
+void platform_close(int fd)
+{
+#ifndef WIN32
+	close(fd);
+#endif
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 // Local Variables:
@@ -36,6 +36,20 @@ unsigned long platform_gen_seed();
 
 bool create_dir(const char* dir);
 
+long platform_fork();
+
+bool platform_wait(long pid);
+
+void platform_exit(int status);
+
+bool platform_pipe(int fds[2]);
+
+bool platform_write(int fd, const void *buf, unsigned long len);
+
+bool platform_read(int fd, void *buf, unsigned long len);
+
+void platform_close(int fd);
+
 ///////////////////////////////////////////////////////////////////////////////
 
 #endif // PLATFORM_H
@@ -13,11 +13,9 @@
 
 #include "rand48.h"
 
-extern unsigned short _rand48_seed[3];
-
 long
-lrand48(void)
+nrand48(unsigned short xseed[3])
 {
-	_dorand48(_rand48_seed);
-	return ((long) _rand48_seed[2] << 15) + ((long) _rand48_seed[1] >> 1);
+	_dorand48(xseed);
+	return ((long) xseed[2] << 15) + ((long) xseed[1] >> 1);
 }
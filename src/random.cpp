@@ -157,6 +157,13 @@ get_sequence(std::string &sequence)
 	rnd->get_sequence(sequence);
 }
 
+void
+get_sequence(SequenceWriter &writer)
+{
+	RandomNumber *rnd = RandomNumber::GetInstance();
+	rnd->get_sequence(writer);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 // Local Variables:
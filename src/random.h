@@ -35,6 +35,7 @@
 #include <string>
 
 class Filter;
+class SequenceWriter;
 
 // Old stuff.
 std::string	RandomHexDigits(int num);
@@ -52,6 +53,7 @@ bool		pure_rnd_flipcoin(const unsigned int p, const Filter *f = NULL, const std:
 std::string	get_prefixed_name(const std::string &name);
 std::string&	trace_depth();
 void		get_sequence(std::string &sequence);
+void		get_sequence(SequenceWriter &writer);
 #if 0
 // Deprecated
 unsigned int*   rnd_shuffle(unsigned int n);
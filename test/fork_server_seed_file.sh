@@ -0,0 +1,31 @@
+#!/bin/sh
+#
+# Feed the fork server its seeds from a regular file.  A child that rewinds
+# the shared stdin offset when it exits makes the server read the same seeds
+# over and over, so check that each seed is answered exactly once.
+
+csmith=$1
+template=$2
+dir=$3
+
+rm -rf "$dir"
+mkdir -p "$dir" || exit 1
+seq 1 6 > "$dir/seeds.txt"
+
+timeout 120 "$csmith" --fork-server --temp-file "$template" \
+	--output-dir "$dir/out" < "$dir/seeds.txt" 2> /dev/null \
+	| grep -E '^[0-9]+ (ok|failed)$' > "$dir/replies.txt"
+
+printf '%s ok\n' 1 2 3 4 5 6 > "$dir/expected.txt"
+if ! cmp -s "$dir/expected.txt" "$dir/replies.txt"; then
+	echo "unexpected fork server replies:"
+	head -20 "$dir/replies.txt"
+	exit 1
+fi
+
+for seed in 1 2 3 4 5 6; do
+	if [ ! -s "$dir/out/$seed.c" ]; then
+		echo "missing program for seed $seed"
+		exit 1
+	fi
+done
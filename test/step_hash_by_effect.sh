@@ -0,0 +1,34 @@
+#!/bin/sh
+#
+# A program generated with --step-hash-by-effect must compile, and end with
+# the same checksum as the program generated from the same seed without it.
+
+csmith=$1
+template=$2
+dir=$3
+runtime_src=$4
+runtime_bin=$5
+cc=${CC:-cc}
+
+rm -rf "$dir"
+mkdir -p "$dir" || exit 1
+
+for seed in 1 2 3; do
+	for mode in plain effect; do
+		flags=
+		[ $mode = effect ] && flags=--step-hash-by-effect
+		"$csmith" --seed $seed $flags --temp-file "$template" \
+			--output "$dir/$mode$seed.c" > /dev/null 2>&1 || exit 1
+		if ! "$cc" -w -I"$runtime_src" -I"$runtime_bin" \
+			"$dir/$mode$seed.c" -o "$dir/$mode$seed"; then
+			echo "seed $seed: $mode program does not compile"
+			exit 1
+		fi
+		timeout 60 "$dir/$mode$seed" | tail -1 > "$dir/$mode$seed.out"
+	done
+	if ! cmp -s "$dir/plain$seed.out" "$dir/effect$seed.out"; then
+		echo "seed $seed: checksums differ"
+		cat "$dir/plain$seed.out" "$dir/effect$seed.out"
+		exit 1
+	fi
+done